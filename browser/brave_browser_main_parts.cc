@@ -6,11 +6,13 @@
 #include "brave/browser/brave_browser_main_parts.h"
 
 #include "base/command_line.h"
+#include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/browsing_data/brave_clear_browsing_data.h"
 #include "brave/browser/tor/buildflags.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_sync/buildflags/buildflags.h"
 #include "brave/components/brave_sync/features.h"
+#include "brave/components/p3a/buildflags.h"
 #include "chrome/common/chrome_features.h"
 #include "components/prefs/pref_service.h"
 #include "components/sync/driver/sync_driver_switches.h"
@@ -109,6 +111,9 @@ void BraveBrowserMainParts::PostBrowserStart() {
 
 void BraveBrowserMainParts::PreShutdown() {
   content::BraveClearBrowsingData::ClearOnExit();
+#if BUILDFLAG(BRAVE_P3A_ENABLED)
+  g_brave_browser_process->PersistPendingP3ALogs();
+#endif  // BUILDFLAG(BRAVE_P3A_ENABLED)
 }
 
 void BraveBrowserMainParts::PreProfileInit() {
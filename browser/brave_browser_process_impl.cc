@@ -352,6 +352,12 @@ brave::BraveP3AService* BraveBrowserProcessImpl::brave_p3a_service() {
   return brave_p3a_service_.get();
 }
 
+void BraveBrowserProcessImpl::PersistPendingP3ALogs() {
+  if (brave_p3a_service_) {
+    brave_p3a_service_->PersistPendingLogs();
+  }
+}
+
 #if BUILDFLAG(BUNDLE_WIDEVINE_CDM)
 BraveWidevineBundleManager*
 BraveBrowserProcessImpl::brave_widevine_bundle_manager() {
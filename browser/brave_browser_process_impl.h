@@ -92,6 +92,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   extensions::BraveTorClientUpdater* tor_client_updater();
 #endif
   brave::BraveP3AService* brave_p3a_service();
+  // Writes pending P3A logs to local state. Does not create the P3A service.
+  void PersistPendingP3ALogs();
 #if BUILDFLAG(BUNDLE_WIDEVINE_CDM)
   BraveWidevineBundleManager* brave_widevine_bundle_manager();
 #endif
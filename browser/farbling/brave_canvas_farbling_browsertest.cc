@@ -0,0 +1,166 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "base/path_service.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "brave/browser/brave_content_browser_client.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/metrics/subprocess_metrics_provider.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/common/chrome_content_client.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+
+using brave_shields::ControlType;
+
+namespace {
+
+const char kCanvasCacheHistogram[] = "Brave.Farbling.BalancedCanvasCacheHit";
+
+const char kDrawCanvasScript[] =
+    "window.canvas = document.createElement('canvas');"
+    "canvas.width = 64;"
+    "canvas.height = 64;"
+    "var ctx = canvas.getContext('2d');"
+    "ctx.fillStyle = '#336699';"
+    "ctx.fillRect(0, 0, 64, 64);"
+    "ctx.fillStyle = '#ff9900';"
+    "ctx.fillRect(8, 8, 32, 16);"
+    "domAutomationController.send(canvas.toDataURL());";
+
+const char kRedrawCanvasScript[] =
+    "var ctx = canvas.getContext('2d');"
+    "ctx.fillStyle = '#00cc66';"
+    "ctx.fillRect(16, 32, 40, 24);"
+    "domAutomationController.send(canvas.toDataURL());";
+
+// Reads the unchanged canvas back several times and reports the result if
+// every read matched the first one
+const char kPollCanvasScript[] =
+    "var first = canvas.toDataURL();"
+    "var same = true;"
+    "for (var i = 0; i < 10; i++) {"
+    "  if (canvas.toDataURL() !== first) {"
+    "    same = false;"
+    "  }"
+    "}"
+    "domAutomationController.send(same ? first : '');";
+
+}  // namespace
+
+class BraveCanvasFarblingBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    content_client_.reset(new ChromeContentClient);
+    content::SetContentClient(content_client_.get());
+    browser_content_client_.reset(new BraveContentBrowserClient());
+    content::SetBrowserClientForTesting(browser_content_client_.get());
+
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+
+    ASSERT_TRUE(embedded_test_server()->Start());
+
+    top_level_page_url_ = embedded_test_server()->GetURL("a.com", "/");
+    simple_url_ = embedded_test_server()->GetURL("a.com", "/simple.html");
+  }
+
+  void TearDown() override {
+    browser_content_client_.reset();
+    content_client_.reset();
+  }
+
+  void AllowFingerprinting() {
+    brave_shields::SetFingerprintingControlType(
+        browser()->profile(), ControlType::ALLOW, top_level_page_url_);
+  }
+
+  void SetFingerprintingDefault() {
+    brave_shields::SetFingerprintingControlType(
+        browser()->profile(), ControlType::DEFAULT, top_level_page_url_);
+  }
+
+  std::string ExecScriptGetStr(const std::string& script) {
+    std::string value;
+    EXPECT_TRUE(ExecuteScriptAndExtractString(contents(), script, &value));
+    return value;
+  }
+
+  content::WebContents* contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  // Returns how often the renderer reused (|hit|) or recomputed the balanced
+  // canvas perturbation
+  int GetCanvasCacheCount(const base::HistogramTester& histogram_tester,
+                          bool hit) {
+    content::FetchHistogramsFromChildProcesses();
+    SubprocessMetricsProvider::MergeHistogramDeltasForTesting();
+    return histogram_tester.GetBucketCount(kCanvasCacheHistogram, hit);
+  }
+
+  bool NavigateToSimplePage() {
+    ui_test_utils::NavigateToURL(browser(), simple_url_);
+    return WaitForLoadStop(contents());
+  }
+
+ private:
+  GURL top_level_page_url_;
+  GURL simple_url_;
+  std::unique_ptr<ChromeContentClient> content_client_;
+  std::unique_ptr<BraveContentBrowserClient> browser_content_client_;
+};
+
+// Tests that reading back an unchanged canvas repeatedly reuses the cached
+// farbled output, and that drawing to it again invalidates the cache
+IN_PROC_BROWSER_TEST_F(BraveCanvasFarblingBrowserTest,
+                       PollUnchangedCanvas) {
+  // Farbling level: off
+  AllowFingerprinting();
+  NavigateToSimplePage();
+  const std::string original = ExecScriptGetStr(kDrawCanvasScript);
+  const std::string original_redrawn = ExecScriptGetStr(kRedrawCanvasScript);
+
+  // Farbling level: balanced (default)
+  SetFingerprintingDefault();
+  NavigateToSimplePage();
+  base::HistogramTester histogram_tester;
+  const std::string farbled = ExecScriptGetStr(kDrawCanvasScript);
+  EXPECT_NE(original, farbled);
+  const int misses = GetCanvasCacheCount(histogram_tester, false);
+  EXPECT_GT(misses, 0);
+  EXPECT_EQ(0, GetCanvasCacheCount(histogram_tester, true));
+
+  // Every poll of the unchanged canvas is served from the cache
+  EXPECT_EQ(farbled, ExecScriptGetStr(kPollCanvasScript));
+  EXPECT_EQ(misses, GetCanvasCacheCount(histogram_tester, false));
+  const int hits = GetCanvasCacheCount(histogram_tester, true);
+  EXPECT_GE(hits, 11);
+
+  // Drawing to the canvas invalidates the cache
+  const std::string farbled_redrawn = ExecScriptGetStr(kRedrawCanvasScript);
+  EXPECT_NE(original_redrawn, farbled_redrawn);
+  EXPECT_NE(farbled, farbled_redrawn);
+  const int redrawn_misses = GetCanvasCacheCount(histogram_tester, false);
+  EXPECT_GT(redrawn_misses, misses);
+  EXPECT_EQ(hits, GetCanvasCacheCount(histogram_tester, true));
+
+  EXPECT_EQ(farbled_redrawn, ExecScriptGetStr(kPollCanvasScript));
+  EXPECT_EQ(redrawn_misses, GetCanvasCacheCount(histogram_tester, false));
+  EXPECT_GE(GetCanvasCacheCount(histogram_tester, true), hits + 11);
+
+  // A new document farbles the same canvas contents the same way
+  NavigateToSimplePage();
+  EXPECT_EQ(farbled, ExecScriptGetStr(kDrawCanvasScript));
+}
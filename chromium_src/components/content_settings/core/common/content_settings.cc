@@ -3,9 +3,20 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
 #define BRAVE_IS_RENDERER_CONTENT_SETTING \
   content_type == ContentSettingsType::AUTOPLAY ||
 
 #include "../../../../../components/content_settings/core/common/content_settings.cc"  // NOLINT
 
 #undef BRAVE_IS_RENDERER_CONTENT_SETTING
+
+namespace content_settings {
+
+uint64_t GetNextRendererContentSettingRulesVersion() {
+  static std::atomic<uint64_t> version(0);
+  return ++version;
+}
+
+}  // namespace content_settings
@@ -6,10 +6,24 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+#include <stdint.h>
+
+namespace content_settings {
+
+// Returns a new, process-unique version for each RendererContentSettingRules
+// instance that is constructed. Rules received over IPC are deserialized into
+// a new instance and then assigned over the renderer's copy, so the version
+// changes whenever the rules are updated even though their address does not.
+uint64_t GetNextRendererContentSettingRulesVersion();
+
+}  // namespace content_settings
+
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  uint64_t brave_rules_version =                  \
+      content_settings::GetNextRendererContentSettingRulesVersion();
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
@@ -5,8 +5,10 @@
 
 #include "third_party/blink/renderer/core/dom/document.h"
 
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "brave/third_party/blink/renderer/brave_farbling_kernels.h"
 #include "crypto/hmac.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -22,11 +24,8 @@
 
 namespace {
 
-const uint64_t zero = 0;
-
-inline uint64_t lfsr_next(uint64_t v) {
-  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
-}
+// Largest canvas, in pixels, whose perturbed copy is kept for reuse (4 MB)
+constexpr size_t kMaxCachedCanvasPixelCount = 1024 * 1024;
 
 float Identity(float value, size_t index) {
   return value;
@@ -45,7 +44,7 @@ float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
     v = seed;
   }
   // get next value in PRNG sequence
-  v = lfsr_next(v);
+  v = brave::lfsr_next(v);
   // return pseudo-random float between 0 and 0.1
   return (v / maxUInt64AsDouble) / 10;
 }
@@ -100,22 +99,51 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         break;
       }
       case BraveFarblingLevel::BALANCED: {
-        const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
-        double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
+        const double fudge_factor = GetAudioFudgeFactor();
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
         return base::BindRepeating(&ConstantMultiplier, fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
-        uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-       return base::BindRepeating(&PseudoRandomSequence, seed);
+        return base::BindRepeating(&PseudoRandomSequence, GetAudioSeed());
       }
     }
   }
   return base::BindRepeating(&Identity);
 }
 
+void BraveSessionCache::FarbleAudioChannel(
+    blink::LocalFrame* frame,
+    float* data,
+    size_t count) {
+  if (!farbling_enabled_ || !frame || !frame->GetContentSettingsClient())
+    return;
+  switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
+    case BraveFarblingLevel::OFF:
+      break;
+    case BraveFarblingLevel::BALANCED: {
+      ScaleAudioSamples(GetAudioFudgeFactor(), data, count);
+      break;
+    }
+    case BraveFarblingLevel::MAXIMUM: {
+      FillWithPseudoRandomAudioSamples(GetAudioSeed(), data, count);
+      break;
+    }
+  }
+}
+
+double BraveSessionCache::GetAudioFudgeFactor() const {
+  // fudge factor between 0.99 and 1.0, based on domain key
+  const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
+  const double maxUInt64AsDouble = UINT64_MAX;
+  return 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
+}
+
+uint64_t BraveSessionCache::GetAudioSeed() const {
+  // initial PRNG seed based on domain key
+  return *reinterpret_cast<const uint64_t*>(domain_key_);
+}
+
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
     blink::LocalFrame* frame,
     scoped_refptr<blink::StaticBitmapImage> image_bitmap) {
@@ -144,6 +172,23 @@ scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbBalanced(
   DCHECK(image_bitmap);
   if (image_bitmap->IsNull())
     return image_bitmap;
+  // reuse the previous result if the same canvas snapshot was already
+  // perturbed. Canvas snapshots keep their content id until the canvas is
+  // drawn to again, so this is checked before reading back any pixels
+  const cc::PaintImage paint_image = image_bitmap->PaintImageForCurrentFrame();
+  const cc::PaintImage::Id paint_image_id = paint_image.stable_id();
+  const cc::PaintImage::ContentId content_id =
+      paint_image.GetContentIdForFrame(0u);
+  BalancedCanvasCacheEntry& cache = balanced_canvas_cache_;
+  if (cache.perturbed_bitmap &&
+      content_id != cc::PaintImage::kInvalidContentId &&
+      cache.paint_image_id == paint_image_id &&
+      cache.content_id == content_id) {
+    LOCAL_HISTOGRAM_BOOLEAN("Brave.Farbling.BalancedCanvasCacheHit", true);
+    return cache.perturbed_bitmap;
+  }
+  LOCAL_HISTOGRAM_BOOLEAN("Brave.Farbling.BalancedCanvasCacheHit", false);
+  cache.perturbed_bitmap = nullptr;
   // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
   // per pixel
   std::unique_ptr<blink::ImageDataBuffer> data_buffer =
@@ -186,6 +231,13 @@ scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbBalanced(
   scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
       blink::UnacceleratedStaticBitmapImage::Create(
           data_buffer->RetainedImage());
+  // the cache keeps the perturbed copy alive, so only small canvases are kept
+  if (content_id != cc::PaintImage::kInvalidContentId &&
+      pixel_count <= kMaxCachedCanvasPixelCount) {
+    cache.paint_image_id = paint_image_id;
+    cache.content_id = content_id;
+    cache.perturbed_bitmap = perturbed_bitmap;
+  }
   return perturbed_bitmap;
 }
 
@@ -202,11 +254,8 @@ scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbMax(
   const uint64_t count = 4 * data_buffer->Width() * data_buffer->Height();
   // initial seed based on domain key
   uint64_t v = *reinterpret_cast<uint64_t*>(domain_key_);
-  // iterate through pixel data and overwrite with next value in PRNG sequence
-  for (uint64_t i = 0; i < count; i++) {
-    pixels[i] = v % 256;
-    v = lfsr_next(v);
-  }
+  // overwrite pixel data with the PRNG sequence
+  FillWithPseudoRandomBytes(v, pixels, count);
   // convert back to a StaticBitmapImage to return to the caller
   scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
       blink::UnacceleratedStaticBitmapImage::Create(
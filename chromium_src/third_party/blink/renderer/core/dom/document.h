@@ -9,6 +9,7 @@
 #include "../../../../../../../third_party/blink/renderer/core/dom/document.h"
 
 #include "base/callback.h"
+#include "cc/paint/paint_image.h"
 
 using blink::Document;
 using blink::GarbageCollected;
@@ -42,16 +43,33 @@ class CORE_EXPORT BraveSessionCache final
 
   AudioFarblingCallback GetAudioFarblingCallback(
       blink::LocalFrame* frame);
+  // Farbles a whole channel of audio samples at once. Produces the same
+  // output as running the audio farbling callback over |data| in order
+  void FarbleAudioChannel(blink::LocalFrame* frame, float* data, size_t count);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::LocalFrame* frame,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
   WTF::String GenerateRandomString(std::string seed, wtf_size_t length);
 
  private:
+  // The most recent canvas snapshot perturbed in balanced mode. Scripts often
+  // read back the same canvas repeatedly, so the perturbed result is reused
+  // while the snapshot content id is unchanged
+  struct BalancedCanvasCacheEntry {
+    cc::PaintImage::Id paint_image_id = cc::PaintImage::kInvalidId;
+    cc::PaintImage::ContentId content_id = cc::PaintImage::kInvalidContentId;
+    scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap;
+  };
+
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  BalancedCanvasCacheEntry balanced_canvas_cache_;
 
+  // Audio farbling parameters shared by GetAudioFarblingCallback and
+  // FarbleAudioChannel, so both paths farble the same way
+  double GetAudioFudgeFactor() const;
+  uint64_t GetAudioSeed() const;
   scoped_refptr<blink::StaticBitmapImage> PerturbBalanced(
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
   scoped_refptr<blink::StaticBitmapImage> PerturbMax(
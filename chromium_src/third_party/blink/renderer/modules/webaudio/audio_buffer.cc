@@ -9,35 +9,28 @@
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/modules/webaudio/analyser_node.h"
 
-#define BRAVE_AUDIOBUFFER_GETCHANNELDATA                                   \
-  NotShared<DOMFloat32Array> array = getChannelData(channel_index);        \
-  LocalDOMWindow* window = LocalDOMWindow::From(script_state);             \
-  if (window) {                                                            \
-    LocalFrame* frame = window->document()->GetFrame();                    \
-    if (frame && frame->GetContentSettingsClient()) {                      \
-      DOMFloat32Array* destination_array = array.View();                   \
-      size_t len = destination_array->lengthAsSizeT();                     \
-      if (len > 0) {                                                       \
-        float* destination = destination_array->Data();                    \
-        brave::AudioFarblingCallback audio_farbling_callback =             \
-            brave::BraveSessionCache::From(*(window->document()))          \
-                .GetAudioFarblingCallback(frame);                          \
-        for (unsigned i = 0; i < len; ++i) {                               \
-          destination[i] = audio_farbling_callback.Run(destination[i], i); \
-        }                                                                  \
-      }                                                                    \
-    }                                                                      \
+#define BRAVE_AUDIOBUFFER_GETCHANNELDATA                            \
+  NotShared<DOMFloat32Array> array = getChannelData(channel_index); \
+  LocalDOMWindow* window = LocalDOMWindow::From(script_state);      \
+  if (window) {                                                     \
+    LocalFrame* frame = window->document()->GetFrame();             \
+    if (frame && frame->GetContentSettingsClient()) {               \
+      DOMFloat32Array* destination_array = array.View();            \
+      size_t len = destination_array->lengthAsSizeT();              \
+      if (len > 0) {                                                \
+        brave::BraveSessionCache::From(*(window->document()))       \
+            .FarbleAudioChannel(frame, destination_array->Data(),   \
+                                len);                               \
+      }                                                             \
+    }                                                               \
   }
 
-#define BRAVE_AUDIOBUFFER_COPYFROMCHANNEL                              \
-  LocalDOMWindow* window = LocalDOMWindow::From(script_state);         \
-  if (window) {                                                        \
-    brave::AudioFarblingCallback audio_farbling_callback =             \
-        brave::BraveSessionCache::From(*(window->document()))          \
-            .GetAudioFarblingCallback(window->document()->GetFrame()); \
-    for (unsigned i = 0; i < count; i++) {                             \
-      dst[i] = audio_farbling_callback.Run(dst[i], i);                 \
-    }                                                                  \
+#define BRAVE_AUDIOBUFFER_COPYFROMCHANNEL                          \
+  LocalDOMWindow* window = LocalDOMWindow::From(script_state);     \
+  if (window) {                                                    \
+    brave::BraveSessionCache::From(*(window->document()))          \
+        .FarbleAudioChannel(window->document()->GetFrame(), dst,   \
+                            count);                                \
   }
 
 #include "../../../../../../third_party/blink/renderer/modules/webaudio/audio_buffer.cc"
@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/stringprintf.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -27,6 +28,133 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Maximum number of words extracted from a page for classification
+const int kMaximumPageTextWordCount = 2000;
+
+// Extracts at most |maxWordCount| whitespace separated words from the text
+// nodes of the page in the renderer, so that long articles and single page
+// apps do not ship multi-megabyte strings to the ads process on every load.
+// Like innerText, text inside hidden elements and script, style, noscript and
+// template elements is left out, text of adjacent inline elements runs
+// together and block boundaries and line breaks separate words
+const char kExtractPageTextScript[] = R"(
+  (function(maxWordCount) {
+    if (!document.body) {
+      return '';
+    }
+
+    const kIgnoredTagNames = ['NOSCRIPT', 'SCRIPT', 'STYLE', 'TEMPLATE'];
+
+    const isHiddenElement = (element) => {
+      if (element.hidden) {
+        return true;
+      }
+
+      if (element.getClientRects().length > 0) {
+        return false;
+      }
+
+      // display: contents elements have no box but their children do
+      return getComputedStyle(element).display !== 'contents';
+    };
+
+    const visibilities = new Map();
+    const isVisibleText = (node) => {
+      const parent = node.parentElement;
+      if (!parent) {
+        return true;
+      }
+
+      if (!visibilities.has(parent)) {
+        visibilities.set(parent,
+            getComputedStyle(parent).visibility === 'visible');
+      }
+      return visibilities.get(parent);
+    };
+
+    // Returns the closest ancestor which is laid out as a block, table cell
+    // or other non inline box
+    const blocks = new Map();
+    const getBlockAncestor = (node) => {
+      let element = node.parentElement;
+      while (element && element !== document.body) {
+        if (!blocks.has(element)) {
+          const display = getComputedStyle(element).display;
+          blocks.set(element,
+              !display.startsWith('inline') && display !== 'contents');
+        }
+        if (blocks.get(element)) {
+          return element;
+        }
+        element = element.parentElement;
+      }
+      return document.body;
+    };
+
+    // Rejecting an element skips its whole subtree, so ignored and hidden
+    // ancestors exclude all of their descendants
+    let isLineBreak = false;
+    const walker = document.createTreeWalker(document.body,
+        NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+      acceptNode: (node) => {
+        if (node.nodeType === Node.ELEMENT_NODE) {
+          if (node.tagName === 'BR') {
+            isLineBreak = true;
+            return NodeFilter.FILTER_SKIP;
+          }
+          if (kIgnoredTagNames.includes(node.tagName) ||
+              isHiddenElement(node)) {
+            return NodeFilter.FILTER_REJECT;
+          }
+          return NodeFilter.FILTER_SKIP;
+        }
+
+        return isVisibleText(node) ?
+            NodeFilter.FILTER_ACCEPT : NodeFilter.FILTER_REJECT;
+      }
+    });
+
+    // A word continues into the next text node, as in foo<b>bar</b>, unless
+    // whitespace, a line break or a block boundary is between them
+    const words = [];
+    let continuesWord = false;
+    let lastBlock = null;
+    while (words.length < maxWordCount && walker.nextNode()) {
+      const text = walker.currentNode.nodeValue;
+      if (!text) {
+        continue;
+      }
+
+      const block = getBlockAncestor(walker.currentNode);
+      if (block !== lastBlock || isLineBreak) {
+        continuesWord = false;
+      }
+      lastBlock = block;
+      isLineBreak = false;
+
+      const pattern = /\S+/g;
+      let match;
+      while ((match = pattern.exec(text)) !== null) {
+        if (continuesWord && match.index === 0) {
+          words[words.length - 1] += match[0];
+        } else if (words.length < maxWordCount) {
+          words.push(match[0]);
+        } else {
+          break;
+        }
+      }
+
+      continuesWord = /\S$/.test(text);
+    }
+
+    return words.join(' ');
+  })(%d)
+)";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -79,13 +207,19 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
   DCHECK(render_frame_host);
 
   dom_distiller::RunIsolatedJavaScript(render_frame_host,
-      "document.body.innerText",
+      GetExtractPageTextScript(kMaximumPageTextWordCount),
           base::BindOnce(&AdsTabHelper::OnWebContentsDistillationDone,
               weak_factory_.GetWeakPtr(),
                   source_page_handle->web_contents()->GetLastCommittedURL(),
                       base::TimeTicks::Now()));
 }
 
+// static
+std::string AdsTabHelper::GetExtractPageTextScript(
+    const int max_word_count) {
+  return base::StringPrintf(kExtractPageTextScript, max_word_count);
+}
+
 void AdsTabHelper::OnWebContentsDistillationDone(
     const GURL& url,
     const base::TimeTicks& javascript_start,
@@ -46,6 +46,11 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  // Returns the script which extracts at most |max_word_count| words of the
+  // visible page text for classification
+  static std::string GetExtractPageTextScript(
+      const int max_word_count);
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_ads/browser/ads_tab_helper.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelperBrowserTest.*
+
+namespace {
+
+const char kTestPage[] = "/brave_ads/page_text.html";
+
+// Splits innerText into words joined by a single space, so that it can be
+// compared with the extracted page text regardless of line breaks and tabs
+const char kGetInnerTextWords[] =
+    "document.body.innerText.split(/\\s+/).filter((word) => word).join(' ')";
+
+}  // namespace
+
+class AdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+    ASSERT_TRUE(embedded_test_server()->Start());
+
+    ui_test_utils::NavigateToURL(browser(),
+        embedded_test_server()->GetURL(kTestPage));
+  }
+
+  content::WebContents* contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  std::string GetPageText(const int max_word_count) {
+    return content::EvalJs(contents(),
+        brave_ads::AdsTabHelper::GetExtractPageTextScript(max_word_count))
+            .ExtractString();
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, PageTextMatchesInnerText) {
+  const std::string inner_text =
+      content::EvalJs(contents(), kGetInnerTextWords).ExtractString();
+  ASSERT_FALSE(inner_text.empty());
+
+  const std::string page_text = GetPageText(2000);
+  EXPECT_EQ(inner_text, page_text);
+
+  EXPECT_EQ(std::string::npos, page_text.find("Hidden"));
+  EXPECT_EQ(std::string::npos, page_text.find("Invisible"));
+  EXPECT_EQ(std::string::npos, page_text.find("Scripted"));
+  EXPECT_NE(std::string::npos, page_text.find("Financing options"));
+  EXPECT_NE(std::string::npos, page_text.find("Dealers"));
+  EXPECT_NE(std::string::npos, page_text.find("drive today"));
+  EXPECT_NE(std::string::npos, page_text.find("Fuelefficient models"));
+  EXPECT_NE(std::string::npos, page_text.find("Trade in"));
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, PageTextIsBounded) {
+  EXPECT_EQ("Shopping for a new", GetPageText(4));
+}
@@ -6,9 +6,11 @@
 #include "brave/components/brave_ads/browser/bundle_state_database.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -28,6 +30,16 @@ namespace {
 const int kCurrentVersionNumber = 8;
 const int kCompatibleVersionNumber = 8;
 
+// SQLite limits the number of binding parameters per statement, so multi-row
+// inserts are split into batches which stay below this limit
+const int kMaximumBindingParameters = 999;
+
+// Only vacuum the database after saving the bundle state if at least this many
+// pages and this fraction of the database are on the freelist, as vacuuming
+// rewrites the whole database file
+const int64_t kMinimumFreelistPagesToVacuum = 256;
+const double kMinimumFreelistRatioToVacuum = 0.25;
+
 }  // namespace
 
 BundleStateDatabase::BundleStateDatabase(
@@ -101,8 +113,8 @@ bool BundleStateDatabase::CreateCategoriesTable() {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateCategory| if you add any new
-  // constraints to the schema
+  // Note: revise implementation for |InsertOrUpdateCategories| if you add any
+  // new constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
           "(name LONGVARCHAR PRIMARY KEY)",
@@ -125,23 +137,39 @@ bool BundleStateDatabase::TruncateCategoriesTable() {
   return statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateCategory(
-    const std::string& category) {
+bool BundleStateDatabase::InsertOrUpdateCategories(
+    const std::vector<std::string>& categories) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO category "
-          "(name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(1).c_str());
+  const int column_count = 1;
+  const size_t batch_size = kMaximumBindingParameters / column_count;
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  for (size_t offset = 0; offset < categories.size(); offset += batch_size) {
+    const size_t count = std::min(batch_size, categories.size() - offset);
 
-  statement.BindString(0, category);
+    const std::string sql = base::StringPrintf(
+        "INSERT OR REPLACE INTO category "
+            "(name) VALUES %s",
+        CreateBindingParameterRowPlaceholders(column_count, count).c_str());
 
-  return statement.Run();
+    sql::Statement statement(count == batch_size ?
+        GetDB().GetCachedStatement(SQL_FROM_HERE, sql.c_str()) :
+        GetDB().GetUniqueStatement(sql.c_str()));
+
+    int index = 0;
+    for (size_t i = offset; i < offset + count; i++) {
+      statement.BindString(index++, categories.at(i));
+    }
+
+    if (!statement.Run()) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 bool BundleStateDatabase::CreateCreativeAdNotificationsTable() {
@@ -152,7 +180,7 @@ bool BundleStateDatabase::CreateCreativeAdNotificationsTable() {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateCreativeAdNotification| if
+  // Note: revise implementation for |InsertOrUpdateCreativeAdNotifications| if
   // you add any new constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
@@ -191,14 +219,28 @@ bool BundleStateDatabase::TruncateCreativeAdNotificationsTable() {
   return statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateCreativeAdNotification(
-    const ads::CreativeAdNotificationInfo& info) {
+bool BundleStateDatabase::InsertOrUpdateCreativeAdNotifications(
+    const ads::CreativeAdNotificationList& ads) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  for (const auto& geo_target : info.geo_targets) {
+  // Each creative ad notification is stored once per geo target
+  std::vector<std::pair<const ads::CreativeAdNotificationInfo*,
+      const std::string*>> rows;
+  for (const auto& info : ads) {
+    for (const auto& geo_target : info.geo_targets) {
+      rows.push_back(std::make_pair(&info, &geo_target));
+    }
+  }
+
+  const int column_count = 15;
+  const size_t batch_size = kMaximumBindingParameters / column_count;
+
+  for (size_t offset = 0; offset < rows.size(); offset += batch_size) {
+    const size_t count = std::min(batch_size, rows.size() - offset);
+
     const std::string sql = base::StringPrintf(
         "INSERT OR REPLACE INTO ad_info "
             "(creative_set_id, "
@@ -215,42 +257,50 @@ bool BundleStateDatabase::InsertOrUpdateCreativeAdNotification(
             "conversion, "
             "per_day, "
             "total_max, "
-            "region) VALUES (%s)",
-      CreateBindingParameterPlaceholders(15).c_str());
-
-    sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-    statement.BindString(0, info.creative_set_id);
-    statement.BindString(1, info.title);
-    statement.BindString(2, info.body);
-    statement.BindString(3, info.target_url);
-
-    base::Time start_at_time;
-    if (base::Time::FromUTCString(info.start_at_timestamp.c_str(),
-        &start_at_time)) {
-      statement.BindInt64(4, start_at_time.ToDoubleT());
-    } else {
-      statement.BindInt64(4, std::numeric_limits<uint64_t>::min());
-    }
+            "region) VALUES %s",
+        CreateBindingParameterRowPlaceholders(column_count, count).c_str());
+
+    sql::Statement statement(count == batch_size ?
+        GetDB().GetCachedStatement(SQL_FROM_HERE, sql.c_str()) :
+        GetDB().GetUniqueStatement(sql.c_str()));
+
+    int index = 0;
+    for (size_t i = offset; i < offset + count; i++) {
+      const ads::CreativeAdNotificationInfo& info = *rows.at(i).first;
+      const std::string& geo_target = *rows.at(i).second;
+
+      statement.BindString(index++, info.creative_set_id);
+      statement.BindString(index++, info.title);
+      statement.BindString(index++, info.body);
+      statement.BindString(index++, info.target_url);
+
+      base::Time start_at_time;
+      if (base::Time::FromUTCString(info.start_at_timestamp.c_str(),
+          &start_at_time)) {
+        statement.BindInt64(index++, start_at_time.ToDoubleT());
+      } else {
+        statement.BindInt64(index++, std::numeric_limits<uint64_t>::min());
+      }
 
-    base::Time end_at_time;
-    if (base::Time::FromUTCString(info.end_at_timestamp.c_str(),
-        &end_at_time)) {
-      statement.BindInt64(5, end_at_time.ToDoubleT());
-    } else {
-      statement.BindInt64(5, std::numeric_limits<uint64_t>::max());
-    }
+      base::Time end_at_time;
+      if (base::Time::FromUTCString(info.end_at_timestamp.c_str(),
+          &end_at_time)) {
+        statement.BindInt64(index++, end_at_time.ToDoubleT());
+      } else {
+        statement.BindInt64(index++, std::numeric_limits<uint64_t>::max());
+      }
 
-    statement.BindString(6, info.creative_instance_id);
-    statement.BindString(7, info.campaign_id);
-    // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
-    statement.BindInt64(8, info.daily_cap);
-    statement.BindString(9, info.advertiser_id);
-    statement.BindInt64(10, info.priority);
-    statement.BindBool(11, info.conversion);
-    statement.BindInt64(12, info.per_day);
-    statement.BindInt64(13, info.total_max);
-    statement.BindString(14, geo_target);
+      statement.BindString(index++, info.creative_instance_id);
+      statement.BindString(index++, info.campaign_id);
+      // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
+      statement.BindInt64(index++, info.daily_cap);
+      statement.BindString(index++, info.advertiser_id);
+      statement.BindInt64(index++, info.priority);
+      statement.BindBool(index++, info.conversion);
+      statement.BindInt64(index++, info.per_day);
+      statement.BindInt64(index++, info.total_max);
+      statement.BindString(index++, geo_target);
+    }
 
     if (!statement.Run()) {
       return false;
@@ -300,26 +350,42 @@ bool BundleStateDatabase::TruncateCreativeAdNotificationCategoriesTable() {
   return statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateCreativeAdNotificationCategory(
-    const ads::CreativeAdNotificationInfo& info,
+bool BundleStateDatabase::InsertOrUpdateCreativeAdNotificationCategories(
+    const ads::CreativeAdNotificationList& ads,
     const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO ad_info_category "
-          "(ad_info_uuid, "
-          "category_name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(2).c_str());
+  const int column_count = 2;
+  const size_t batch_size = kMaximumBindingParameters / column_count;
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  for (size_t offset = 0; offset < ads.size(); offset += batch_size) {
+    const size_t count = std::min(batch_size, ads.size() - offset);
+
+    const std::string sql = base::StringPrintf(
+        "INSERT OR REPLACE INTO ad_info_category "
+            "(ad_info_uuid, "
+            "category_name) VALUES %s",
+        CreateBindingParameterRowPlaceholders(column_count, count).c_str());
+
+    sql::Statement statement(count == batch_size ?
+        GetDB().GetCachedStatement(SQL_FROM_HERE, sql.c_str()) :
+        GetDB().GetUniqueStatement(sql.c_str()));
+
+    int index = 0;
+    for (size_t i = offset; i < offset + count; i++) {
+      statement.BindString(index++, ads.at(i).creative_instance_id);
+      statement.BindString(index++, category);
+    }
 
-  statement.BindString(0, info.creative_instance_id);
-  statement.BindString(1, category);
+    if (!statement.Run()) {
+      return false;
+    }
+  }
 
-  return statement.Run();
+  return true;
 }
 
 bool
@@ -341,8 +407,8 @@ bool BundleStateDatabase::CreateAdConversionsTable() {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateAdConversion| if you add any
-  // new constraints to the schema
+  // Note: revise implementation for |InsertOrUpdateAdConversions| if you add
+  // any new constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
           "(creative_set_id LONGVARCHAR NOT NULL, "
@@ -372,32 +438,51 @@ bool BundleStateDatabase::PurgeExpiredAdConversions() {
   return statement.Run();
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdConversion(
-    const ads::AdConversionInfo& info) {
+bool BundleStateDatabase::InsertOrUpdateAdConversions(
+    const ads::AdConversionList& ad_conversions) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO ad_conversions "
-          "(creative_set_id, "
-          "type, "
-          "url_pattern, "
-          "observation_window, "
-          "expiry_timestamp) VALUES (%s)",
-      CreateBindingParameterPlaceholders(5).c_str());
+  const int column_count = 5;
+  const size_t batch_size = kMaximumBindingParameters / column_count;
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+  for (size_t offset = 0; offset < ad_conversions.size();
+      offset += batch_size) {
+    const size_t count = std::min(batch_size, ad_conversions.size() - offset);
 
-  statement.BindString(0, info.creative_set_id);
-  statement.BindString(1, info.type);
-  statement.BindString(2, info.url_pattern);
-  // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast
-  statement.BindInt64(3, info.observation_window);
-  statement.BindInt64(4, info.expiry_timestamp);
+    const std::string sql = base::StringPrintf(
+        "INSERT OR REPLACE INTO ad_conversions "
+            "(creative_set_id, "
+            "type, "
+            "url_pattern, "
+            "observation_window, "
+            "expiry_timestamp) VALUES %s",
+        CreateBindingParameterRowPlaceholders(column_count, count).c_str());
+
+    sql::Statement statement(count == batch_size ?
+        GetDB().GetCachedStatement(SQL_FROM_HERE, sql.c_str()) :
+        GetDB().GetUniqueStatement(sql.c_str()));
+
+    int index = 0;
+    for (size_t i = offset; i < offset + count; i++) {
+      const ads::AdConversionInfo& info = ad_conversions.at(i);
+
+      statement.BindString(index++, info.creative_set_id);
+      statement.BindString(index++, info.type);
+      statement.BindString(index++, info.url_pattern);
+      // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast
+      statement.BindInt64(index++, info.observation_window);
+      statement.BindInt64(index++, info.expiry_timestamp);
+    }
 
-  return statement.Run();
+    if (!statement.Run()) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 bool BundleStateDatabase::SaveBundleState(
@@ -419,36 +504,44 @@ bool BundleStateDatabase::SaveBundleState(
     return false;
   }
 
+  std::vector<std::string> categories;
+  categories.reserve(bundle_state.creative_ad_notifications.size());
   for (const auto& creative_ad_notification :
       bundle_state.creative_ad_notifications) {
-    const std::string category = creative_ad_notification.first;
-    if (!InsertOrUpdateCategory(category)) {
-      GetDB().RollbackTransaction();
-      return false;
-    }
+    categories.push_back(creative_ad_notification.first);
+  }
 
-    const ads::CreativeAdNotificationList ads = creative_ad_notification.second;
-    for (const auto& ad : ads) {
-      if (!InsertOrUpdateCreativeAdNotification(ad) ||
-          !InsertOrUpdateCreativeAdNotificationCategory(ad, category)) {
-        GetDB().RollbackTransaction();
-        return false;
-      }
-    }
+  if (!InsertOrUpdateCategories(categories)) {
+    GetDB().RollbackTransaction();
+    return false;
   }
 
-  for (const auto& ad_conversion : bundle_state.ad_conversions) {
-    if (!InsertOrUpdateAdConversion(ad_conversion)) {
+  for (const auto& creative_ad_notification :
+      bundle_state.creative_ad_notifications) {
+    const std::string& category = creative_ad_notification.first;
+    const ads::CreativeAdNotificationList& ads =
+        creative_ad_notification.second;
+
+    if (!InsertOrUpdateCreativeAdNotifications(ads) ||
+        !InsertOrUpdateCreativeAdNotificationCategories(ads, category)) {
       GetDB().RollbackTransaction();
       return false;
     }
   }
 
+  if (!InsertOrUpdateAdConversions(bundle_state.ad_conversions)) {
+    GetDB().RollbackTransaction();
+    return false;
+  }
+
   if (!GetDB().CommitTransaction()) {
     return false;
   }
 
-  Vacuum();
+  if (ShouldVacuum()) {
+    Vacuum();
+  }
+
   return true;
 }
 
@@ -568,6 +661,26 @@ std::string BundleStateDatabase::CreateBindingParameterPlaceholders(
   return placeholders;
 }
 
+std::string BundleStateDatabase::CreateBindingParameterRowPlaceholders(
+    const size_t column_count,
+    const size_t row_count) {
+  const std::string placeholders = base::StringPrintf("(%s)",
+      CreateBindingParameterPlaceholders(column_count).c_str());
+
+  std::string row_placeholders;
+  row_placeholders.reserve((placeholders.size() + 2) * row_count);
+
+  for (size_t i = 0; i < row_count; i++) {
+    if (i != 0) {
+      row_placeholders += ", ";
+    }
+
+    row_placeholders += placeholders;
+  }
+
+  return row_placeholders;
+}
+
 // static
 int BundleStateDatabase::GetCurrentVersion() {
   return kCurrentVersionNumber;
@@ -585,6 +698,39 @@ void BundleStateDatabase::Vacuum() {
   ignore_result(db_.Execute("VACUUM"));
 }
 
+bool BundleStateDatabase::ShouldVacuum() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!is_initialized_) {
+    return false;
+  }
+
+  sql::Statement page_count_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE, "PRAGMA page_count"));
+  if (!page_count_statement.Step()) {
+    return false;
+  }
+
+  const int64_t page_count = page_count_statement.ColumnInt64(0);
+  if (page_count <= 0) {
+    return false;
+  }
+
+  sql::Statement freelist_count_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE, "PRAGMA freelist_count"));
+  if (!freelist_count_statement.Step()) {
+    return false;
+  }
+
+  const int64_t freelist_count = freelist_count_statement.ColumnInt64(0);
+  if (freelist_count < kMinimumFreelistPagesToVacuum) {
+    return false;
+  }
+
+  return static_cast<double>(freelist_count) / page_count >=
+      kMinimumFreelistRatioToVacuum;
+}
+
 void BundleStateDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -56,7 +56,8 @@ class BundleStateDatabase {
   static int GetCurrentVersion();
 
   // Vacuums the database. This will cause sqlite to defragment and collect
-  // unused space in the file. It can be VERY SLOW
+  // unused space in the file. It can be VERY SLOW, so is only done after saving
+  // the bundle state if |ShouldVacuum| returns true
   void Vacuum();
 
   std::string GetDiagnosticInfo(
@@ -70,29 +71,35 @@ class BundleStateDatabase {
 
   bool CreateCategoriesTable();
   bool TruncateCategoriesTable();
-  bool InsertOrUpdateCategory(
-      const std::string& category);
+  bool InsertOrUpdateCategories(
+      const std::vector<std::string>& categories);
 
   bool CreateCreativeAdNotificationsTable();
   bool TruncateCreativeAdNotificationsTable();
-  bool InsertOrUpdateCreativeAdNotification(
-      const ads::CreativeAdNotificationInfo& info);
+  bool InsertOrUpdateCreativeAdNotifications(
+      const ads::CreativeAdNotificationList& ads);
 
   bool CreateCreativeAdNotificationCategoriesTable();
   bool TruncateCreativeAdNotificationCategoriesTable();
-  bool InsertOrUpdateCreativeAdNotificationCategory(
-      const ads::CreativeAdNotificationInfo& info,
+  bool InsertOrUpdateCreativeAdNotificationCategories(
+      const ads::CreativeAdNotificationList& ads,
       const std::string& category);
 
   bool CreateCreativeAdNotificationCategoriesCategoryIndex();
 
   bool CreateAdConversionsTable();
   bool PurgeExpiredAdConversions();
-  bool InsertOrUpdateAdConversion(
-      const ads::AdConversionInfo& info);
+  bool InsertOrUpdateAdConversions(
+      const ads::AdConversionList& ad_conversions);
 
   std::string CreateBindingParameterPlaceholders(
       const size_t count);
+  std::string CreateBindingParameterRowPlaceholders(
+      const size_t column_count,
+      const size_t row_count);
+
+  // Returns true if enough of the database is unused to be worth vacuuming
+  bool ShouldVacuum();
 
   sql::Database& GetDB();
   sql::MetaTable& GetMetaTable();
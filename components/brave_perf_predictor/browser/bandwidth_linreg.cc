@@ -11,12 +11,36 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
+constexpr char kThirdPartyPrefix[] = "thirdParties.";
+constexpr char kBlockedSuffix[] = ".blocked";
+
+base::flat_map<std::string, size_t> BuildThirdPartyBlockedFeatures() {
+  std::vector<std::pair<std::string, size_t>> features;
+  for (size_t i = kNumericFeatureCount; i < feature_count; i++) {
+    const std::string& name = feature_sequence[i];
+    if (!base::StartsWith(name, kThirdPartyPrefix,
+                          base::CompareCase::SENSITIVE) ||
+        !base::EndsWith(name, kBlockedSuffix, base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+    const size_t prefix_length = sizeof(kThirdPartyPrefix) - 1;
+    const size_t suffix_length = sizeof(kBlockedSuffix) - 1;
+    features.emplace_back(
+        name.substr(prefix_length,
+                    name.size() - prefix_length - suffix_length),
+        i);
+  }
+  return base::flat_map<std::string, size_t>(std::move(features));
+}
+
 bool StandardiseFeatsNoOutliers(
     std::array<double, standardise_feat_count>* features,
     const std::array<double, standardise_feat_count>& means,
@@ -37,7 +61,16 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
-double LinregPredictVector(const std::array<double, feature_count>& features) {
+base::Optional<size_t> GetThirdPartyBlockedFeature(const std::string& name) {
+  static const base::NoDestructor<base::flat_map<std::string, size_t>>
+      third_party_features(BuildThirdPartyBlockedFeatures());
+  const auto it = third_party_features->find(name);
+  if (it == third_party_features->end())
+    return base::nullopt;
+  return it->second;
+}
+
+double LinregPredictVector(const FeatureVector& features) {
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
   std::copy(features.begin(), features.begin() + standardise_feat_count,
@@ -50,7 +83,7 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
   }
 
   // Create a new feature vector to include all features
-  std::array<double, feature_count> standardised_features;
+  FeatureVector standardised_features;
   std::move(numeric_features.begin(), numeric_features.end(),
             standardised_features.begin());
   // Just copy the rest of the features as-is
@@ -66,7 +99,7 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
 }
 
 double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
-  std::array<double, feature_count> feature_vector{};
+  FeatureVector feature_vector{};
   for (unsigned int i = 0; i < feature_count; i++) {
     auto it = features.find(feature_sequence.at(i));
     if (it != features.end())
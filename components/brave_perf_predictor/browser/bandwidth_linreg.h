@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,10 +19,48 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+using FeatureVector = std::array<double, feature_count>;
+
+// Positions of the numeric features in the model feature vector, following
+// the order of |feature_sequence|. Per-resource-type features come in
+// (requestCount, size) pairs.
+enum NumericFeature : size_t {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+  kNumericFeatureCount,
+};
+static_assert(kNumericFeatureCount == standardise_feat_count,
+              "Numeric features must match the standardised model features");
+
+// Returns the position of the "thirdParties.<name>.blocked" feature in the
+// model feature vector, or nullopt if the model does not use that entity.
+base::Optional<size_t> GetThirdPartyBlockedFeature(const std::string& name);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
-double LinregPredictVector(const std::array<double, feature_count>& features);
+double LinregPredictVector(const FeatureVector& features);
 
 // Computes prediction based on key-value map of features.
 // It translates the map to a feature vector internally, and
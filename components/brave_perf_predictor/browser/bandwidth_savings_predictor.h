@@ -8,8 +8,8 @@
 
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -64,7 +64,10 @@ class BandwidthSavingsPredictor {
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Model features, indexed as in |feature_sequence|.
+  FeatureVector features_{};
+  // Not a model feature, only used for the sanity check of the prediction.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
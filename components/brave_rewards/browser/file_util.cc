@@ -99,20 +99,11 @@ bool TruncateFileFromEndAsString(
   return true;
 }
 
-bool TruncateFileFromEnd(
+bool ReplaceFileContents(
     base::File* file,
-    const int64_t offset) {
+    const std::string& value) {
   DCHECK(file);
 
-  if (offset == 0) {
-    return true;
-  }
-
-  std::string value;
-  if (!TruncateFileFromEndAsString(file, offset, &value)) {
-    return false;
-  }
-
   if (file->Seek(base::File::FROM_BEGIN, 0) == -1) {
     return false;
   }
@@ -132,21 +123,37 @@ bool TruncateFileFromEnd(
 
 }  // namespace
 
-bool TailFile(
+bool TailFileToSize(
     base::File* file,
-    const int num_lines) {
+    const int64_t size) {
   DCHECK(file);
+  DCHECK_GE(size, 0);
 
-  if (file->GetLength() == 0) {
+  const int64_t length = file->GetLength();
+  if (length == -1) {
+    return false;
+  }
+
+  if (length <= size) {
     return true;
   }
 
-  const int64_t offset = SeekNumLines(file, num_lines);
-  if (offset == -1) {
+  // Read from one byte earlier so that a cut landing exactly on the start of
+  // a line keeps that line
+  std::string value;
+  if (!TruncateFileFromEndAsString(file, length - size - 1, &value)) {
     return false;
   }
 
-  return TruncateFileFromEnd(file, offset);
+  // Drop the partial line at the start of the kept data
+  const size_t pos = value.find('\n');
+  if (pos == std::string::npos) {
+    value.clear();
+  } else {
+    value.erase(0, pos + 1);
+  }
+
+  return ReplaceFileContents(file, value);
 }
 
 bool TailFileAsString(
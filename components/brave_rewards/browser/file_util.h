@@ -6,15 +6,18 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_FILE_UTIL_H_
 
+#include <stdint.h>
+
 #include <string>
 
 #include "base/files/file.h"
 
 namespace brave_rewards {
 
-bool TailFile(
+// Keeps at most |size| bytes of complete lines at the end of |file|
+bool TailFileToSize(
     base::File* file,
-    const int num_lines);
+    const int64_t size);
 
 bool TailFileAsString(
     base::File* file,
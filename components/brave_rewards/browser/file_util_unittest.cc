@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/file_util.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsFileUtilTest.*
+
+namespace brave_rewards {
+
+class RewardsFileUtilTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_.Initialize(temp_dir_.GetPath().AppendASCII("Rewards.log"),
+        base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_READ |
+            base::File::FLAG_WRITE);
+    ASSERT_TRUE(file_.IsValid());
+  }
+
+  void Write(const std::string& value) {
+    ASSERT_EQ(file_.Write(0, value.c_str(), value.size()),
+        static_cast<int>(value.size()));
+  }
+
+  std::string Read() {
+    std::string value;
+    EXPECT_TRUE(TailFileAsString(&file_, -1, &value));
+    return value;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::File file_;
+};
+
+TEST_F(RewardsFileUtilTest, TailFileToSizeKeepsSmallerFile) {
+  Write("first\nsecond\n");
+  EXPECT_TRUE(TailFileToSize(&file_, 100));
+  EXPECT_EQ(Read(), "first\nsecond\n");
+}
+
+TEST_F(RewardsFileUtilTest, TailFileToSizeKeepsCompleteLines) {
+  Write("first\nsecond\nthird\n");
+  EXPECT_TRUE(TailFileToSize(&file_, 10));
+  EXPECT_EQ(file_.GetLength(), 6);
+  EXPECT_EQ(Read(), "third\n");
+}
+
+TEST_F(RewardsFileUtilTest, TailFileToSizeOnLineBoundary) {
+  Write("first\nsecond\nthird\n");
+  EXPECT_TRUE(TailFileToSize(&file_, 13));
+  EXPECT_EQ(Read(), "second\nthird\n");
+}
+
+}  // namespace brave_rewards
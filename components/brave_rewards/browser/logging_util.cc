@@ -81,6 +81,13 @@ std::string TimeFormatForLog(
 
 }  // namespace
 
+DiagnosticLogEntry::DiagnosticLogEntry() = default;
+
+DiagnosticLogEntry::DiagnosticLogEntry(
+    const DiagnosticLogEntry& entry) = default;
+
+DiagnosticLogEntry::~DiagnosticLogEntry() = default;
+
 bool InitializeLog(
     base::File* file,
     const base::FilePath& path) {
@@ -140,4 +147,15 @@ std::string FriendlyFormatLogEntry(
   return log_entry;
 }
 
+std::string FriendlyFormatLogEntries(
+    const std::vector<DiagnosticLogEntry>& entries) {
+  std::string log_entries;
+  for (const auto& entry : entries) {
+    log_entries += FriendlyFormatLogEntry(entry.time, entry.file, entry.line,
+        entry.verbose_level, entry.message);
+  }
+
+  return log_entries;
+}
+
 }  // namespace brave_rewards
@@ -7,12 +7,25 @@
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_LOGGING_UTIL_H_
 
 #include <string>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/time/time.h"
 
 namespace brave_rewards {
 
+struct DiagnosticLogEntry {
+  DiagnosticLogEntry();
+  DiagnosticLogEntry(const DiagnosticLogEntry& entry);
+  ~DiagnosticLogEntry();
+
+  base::Time time;
+  std::string file;
+  int line = 0;
+  int verbose_level = 0;
+  std::string message;
+};
+
 bool InitializeLog(
     base::File* file,
     const base::FilePath& path);
@@ -24,6 +37,10 @@ std::string FriendlyFormatLogEntry(
     const int verbose_level,
     const std::string& message);
 
+// Formats |entries| in order as a single string
+std::string FriendlyFormatLogEntries(
+    const std::vector<DiagnosticLogEntry>& entries);
+
 bool WriteToLog(
     base::File* file,
     const std::string& log_entry);
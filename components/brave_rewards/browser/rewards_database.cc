@@ -100,6 +100,83 @@ ledger::DBRecordPtr CreateRecord(
   return record;
 }
 
+ledger::DBColumnsPtr CreateColumns(
+    const std::vector<ledger::DBCommand::RecordBindingType>& bindings) {
+  auto columns = ledger::DBColumns::New();
+  for (const auto& binding : bindings) {
+    auto values = ledger::DBColumnValues::New();
+    switch (binding) {
+      case ledger::DBCommand::RecordBindingType::STRING_TYPE: {
+        values->set_string_values(std::vector<std::string>());
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::INT_TYPE: {
+        values->set_int_values(std::vector<int32_t>());
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::INT64_TYPE: {
+        values->set_int64_values(std::vector<int64_t>());
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::DOUBLE_TYPE: {
+        values->set_double_values(std::vector<double>());
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::BOOL_TYPE: {
+        values->set_bool_values(std::vector<bool>());
+        break;
+      }
+      default: {
+        NOTREACHED();
+      }
+    }
+    columns->columns.push_back(std::move(values));
+  }
+
+  return columns;
+}
+
+void AppendRow(
+    sql::Statement* statement,
+    const std::vector<ledger::DBCommand::RecordBindingType>& bindings,
+    ledger::DBColumns* columns) {
+  if (!statement || !columns) {
+    return;
+  }
+
+  for (size_t column = 0; column < bindings.size(); column++) {
+    ledger::DBColumnValues* values = columns->columns[column].get();
+    switch (bindings[column]) {
+      case ledger::DBCommand::RecordBindingType::STRING_TYPE: {
+        values->get_string_values().push_back(
+            statement->ColumnString(column));
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::INT_TYPE: {
+        values->get_int_values().push_back(statement->ColumnInt(column));
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::INT64_TYPE: {
+        values->get_int64_values().push_back(statement->ColumnInt64(column));
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::DOUBLE_TYPE: {
+        values->get_double_values().push_back(
+            statement->ColumnDouble(column));
+        break;
+      }
+      case ledger::DBCommand::RecordBindingType::BOOL_TYPE: {
+        values->get_bool_values().push_back(statement->ColumnBool(column));
+        break;
+      }
+      default: {
+        NOTREACHED();
+      }
+    }
+  }
+  columns->row_count++;
+}
+
 }  // namespace
 
 RewardsDatabase::RewardsDatabase(const base::FilePath& db_path) :
@@ -178,6 +255,88 @@ void RewardsDatabase::RunTransaction(
   }
 }
 
+std::vector<ledger::DBCommandResponsePtr>
+RewardsDatabase::RunWriteTransactions(
+    std::vector<ledger::DBTransactionPtr> transactions) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::vector<ledger::DBCommandResponsePtr> responses;
+  for (size_t i = 0; i < transactions.size(); i++) {
+    auto response = ledger::DBCommandResponse::New();
+    response->status = ledger::DBCommandResponse::Status::RESPONSE_OK;
+    responses.push_back(std::move(response));
+  }
+
+  auto fail_all = [&responses](ledger::DBCommandResponse::Status status) {
+    for (auto& response : responses) {
+      response->status = status;
+    }
+    return std::move(responses);
+  };
+
+  if (!db_.is_open() && !db_.Open(db_path_)) {
+    return fail_all(
+        ledger::DBCommandResponse::Status::INITIALIZATION_ERROR);
+  }
+
+  sql::Transaction committer(&db_);
+  if (!committer.Begin()) {
+    return fail_all(ledger::DBCommandResponse::Status::TRANSACTION_ERROR);
+  }
+
+  for (size_t i = 0; i < transactions.size(); i++) {
+    DCHECK(transactions[i]);
+    DCHECK(IsWriteOnlyTransaction(*transactions[i]));
+    responses[i]->status = RunWriteTransaction(*transactions[i]);
+  }
+
+  if (!committer.Commit()) {
+    return fail_all(ledger::DBCommandResponse::Status::TRANSACTION_ERROR);
+  }
+
+  return responses;
+}
+
+// static
+bool RewardsDatabase::IsWriteOnlyTransaction(
+    const ledger::DBTransaction& transaction) {
+  if (transaction.commands.empty()) {
+    return false;
+  }
+
+  for (const auto& command : transaction.commands) {
+    if (command->type != ledger::DBCommand::Type::RUN) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+ledger::DBCommandResponse::Status RewardsDatabase::RunWriteTransaction(
+    const ledger::DBTransaction& transaction) {
+  if (!db_.Execute("SAVEPOINT ledger_write")) {
+    return ledger::DBCommandResponse::Status::TRANSACTION_ERROR;
+  }
+
+  for (auto const& command : transaction.commands) {
+    VLOG(8) << "Query: " << command->command;
+
+    const auto status = Run(command.get());
+    if (status != ledger::DBCommandResponse::Status::RESPONSE_OK) {
+      db_.Execute("ROLLBACK TO SAVEPOINT ledger_write");
+      db_.Execute("RELEASE SAVEPOINT ledger_write");
+      return status;
+    }
+  }
+
+  if (!db_.Execute("RELEASE SAVEPOINT ledger_write")) {
+    return ledger::DBCommandResponse::Status::TRANSACTION_ERROR;
+  }
+
+  return ledger::DBCommandResponse::Status::RESPONSE_OK;
+}
+
 ledger::DBCommandResponse::Status RewardsDatabase::Initialize(
     const int32_t version,
     const int32_t compatible_version,
@@ -286,6 +445,18 @@ ledger::DBCommandResponse::Status RewardsDatabase::Read(
     HandleBinding(&statement, *binding.get());
   }
 
+  if (command->record_layout == ledger::DBCommand::RecordLayout::COLUMNS) {
+    auto columns = CreateColumns(command->record_bindings);
+    while (statement.Step()) {
+      AppendRow(&statement, command->record_bindings, columns.get());
+    }
+
+    auto result = ledger::DBCommandResult::New();
+    result->set_columns(std::move(columns));
+    response->result = std::move(result);
+    return ledger::DBCommandResponse::Status::RESPONSE_OK;
+  }
+
   auto result = ledger::DBCommandResult::New();
   result->set_records(std::vector<ledger::DBRecordPtr>());
   response->result = std::move(result);
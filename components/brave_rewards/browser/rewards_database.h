@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_DATABASE_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
@@ -29,7 +30,21 @@ class RewardsDatabase {
       ledger::DBTransactionPtr transaction,
       ledger::DBCommandResponse* response);
 
+  // Runs |transactions| inside one SQLite transaction, each in its own
+  // savepoint so that a failing transaction is rolled back without affecting
+  // the others. Returns one response per transaction, in order. Only
+  // transactions for which |IsWriteOnlyTransaction| is true may be batched.
+  std::vector<ledger::DBCommandResponsePtr> RunWriteTransactions(
+      std::vector<ledger::DBTransactionPtr> transactions);
+
+  // Returns true if |transaction| only runs RUN commands, which makes it
+  // safe to batch with other such transactions.
+  static bool IsWriteOnlyTransaction(const ledger::DBTransaction& transaction);
+
  private:
+  ledger::DBCommandResponse::Status RunWriteTransaction(
+      const ledger::DBTransaction& transaction);
+
   ledger::DBCommandResponse::Status Initialize(
       const int32_t version,
       const int32_t compatible_version,
@@ -0,0 +1,217 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_database.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "sql/test/scoped_error_expecter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/sqlite/sqlite3.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsDatabaseTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+ledger::DBCommandPtr CreateCommand(
+    const ledger::DBCommand::Type type,
+    const std::string& query) {
+  auto command = ledger::DBCommand::New();
+  command->type = type;
+  command->command = query;
+  return command;
+}
+
+ledger::DBCommandPtr CreateTypedColumnsRead(const std::string& query) {
+  auto command = CreateCommand(ledger::DBCommand::Type::READ, query);
+  command->record_bindings = {
+      ledger::DBCommand::RecordBindingType::STRING_TYPE,
+      ledger::DBCommand::RecordBindingType::INT_TYPE,
+      ledger::DBCommand::RecordBindingType::INT64_TYPE,
+      ledger::DBCommand::RecordBindingType::DOUBLE_TYPE,
+      ledger::DBCommand::RecordBindingType::BOOL_TYPE
+  };
+  command->record_layout = ledger::DBCommand::RecordLayout::COLUMNS;
+  return command;
+}
+
+ledger::DBTransactionPtr CreateInsertTransaction(const std::string& table) {
+  auto transaction = ledger::DBTransaction::New();
+  transaction->commands.push_back(CreateCommand(
+      ledger::DBCommand::Type::RUN,
+      "INSERT INTO " + table + " (value) VALUES (1)"));
+  return transaction;
+}
+
+}  // namespace
+
+class RewardsDatabaseTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<RewardsDatabase>(
+        temp_dir_.GetPath().AppendASCII("publisher_info_db"));
+
+    auto transaction = ledger::DBTransaction::New();
+    transaction->version = 1;
+    transaction->compatible_version = 1;
+    transaction->commands.push_back(
+        CreateCommand(ledger::DBCommand::Type::INITIALIZE, ""));
+    transaction->commands.push_back(CreateCommand(
+        ledger::DBCommand::Type::EXECUTE,
+        "CREATE TABLE test (value INTEGER NOT NULL)"));
+
+    auto response = ledger::DBCommandResponse::New();
+    database_->RunTransaction(std::move(transaction), response.get());
+    ASSERT_EQ(response->status,
+              ledger::DBCommandResponse::Status::RESPONSE_OK);
+  }
+
+  size_t CountRows() {
+    auto transaction = ledger::DBTransaction::New();
+    auto command = CreateCommand(
+        ledger::DBCommand::Type::READ,
+        "SELECT value FROM test");
+    command->record_bindings = {
+        ledger::DBCommand::RecordBindingType::INT_TYPE
+    };
+    transaction->commands.push_back(std::move(command));
+
+    auto response = ledger::DBCommandResponse::New();
+    database_->RunTransaction(std::move(transaction), response.get());
+    return response->result->get_records().size();
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<RewardsDatabase> database_;
+};
+
+TEST_F(RewardsDatabaseTest, IsWriteOnlyTransaction) {
+  EXPECT_TRUE(RewardsDatabase::IsWriteOnlyTransaction(
+      *CreateInsertTransaction("test")));
+
+  auto read = ledger::DBTransaction::New();
+  read->commands.push_back(
+      CreateCommand(ledger::DBCommand::Type::READ, "SELECT value FROM test"));
+  EXPECT_FALSE(RewardsDatabase::IsWriteOnlyTransaction(*read));
+
+  auto mixed = CreateInsertTransaction("test");
+  mixed->commands.push_back(
+      CreateCommand(ledger::DBCommand::Type::EXECUTE, "DROP TABLE test"));
+  EXPECT_FALSE(RewardsDatabase::IsWriteOnlyTransaction(*mixed));
+
+  EXPECT_FALSE(
+      RewardsDatabase::IsWriteOnlyTransaction(*ledger::DBTransaction::New()));
+}
+
+TEST_F(RewardsDatabaseTest, RunWriteTransactions) {
+  std::vector<ledger::DBTransactionPtr> transactions;
+  transactions.push_back(CreateInsertTransaction("test"));
+  transactions.push_back(CreateInsertTransaction("test"));
+  transactions.push_back(CreateInsertTransaction("test"));
+
+  auto responses = database_->RunWriteTransactions(std::move(transactions));
+  ASSERT_EQ(responses.size(), 3u);
+  for (const auto& response : responses) {
+    EXPECT_EQ(response->status,
+              ledger::DBCommandResponse::Status::RESPONSE_OK);
+  }
+  EXPECT_EQ(CountRows(), 3u);
+}
+
+TEST_F(RewardsDatabaseTest, RunWriteTransactionsRollsBackOnlyFailed) {
+  std::vector<ledger::DBTransactionPtr> transactions;
+  transactions.push_back(CreateInsertTransaction("test"));
+
+  // The first insert succeeds and must be undone with the rest of its
+  // transaction when the second one fails.
+  auto failing = CreateInsertTransaction("test");
+  failing->commands.push_back(CreateCommand(
+      ledger::DBCommand::Type::RUN,
+      "INSERT INTO test (value) VALUES (NULL)"));
+  transactions.push_back(std::move(failing));
+
+  transactions.push_back(CreateInsertTransaction("test"));
+
+  sql::test::ScopedErrorExpecter expecter;
+  expecter.ExpectError(SQLITE_CONSTRAINT);
+  auto responses = database_->RunWriteTransactions(std::move(transactions));
+  EXPECT_TRUE(expecter.SawExpectedErrors());
+  ASSERT_EQ(responses.size(), 3u);
+  EXPECT_EQ(responses[0]->status,
+            ledger::DBCommandResponse::Status::RESPONSE_OK);
+  EXPECT_EQ(responses[1]->status,
+            ledger::DBCommandResponse::Status::COMMAND_ERROR);
+  EXPECT_EQ(responses[2]->status,
+            ledger::DBCommandResponse::Status::RESPONSE_OK);
+  EXPECT_EQ(CountRows(), 2u);
+}
+
+TEST_F(RewardsDatabaseTest, ReadColumns) {
+  auto transaction = ledger::DBTransaction::New();
+  transaction->commands.push_back(CreateCommand(
+      ledger::DBCommand::Type::EXECUTE,
+      "CREATE TABLE typed (s TEXT, i INTEGER, i64 INTEGER, d DOUBLE, "
+      "b BOOLEAN)"));
+  transaction->commands.push_back(CreateCommand(
+      ledger::DBCommand::Type::RUN,
+      "INSERT INTO typed VALUES ('brave', -7, 8589934592, 1.5, 1)"));
+  transaction->commands.push_back(CreateCommand(
+      ledger::DBCommand::Type::RUN,
+      "INSERT INTO typed VALUES (NULL, NULL, NULL, NULL, NULL)"));
+  auto response = ledger::DBCommandResponse::New();
+  database_->RunTransaction(std::move(transaction), response.get());
+  ASSERT_EQ(response->status,
+            ledger::DBCommandResponse::Status::RESPONSE_OK);
+
+  transaction = ledger::DBTransaction::New();
+  transaction->commands.push_back(CreateTypedColumnsRead(
+      "SELECT s, i, i64, d, b FROM typed ORDER BY rowid"));
+  response = ledger::DBCommandResponse::New();
+  database_->RunTransaction(std::move(transaction), response.get());
+  ASSERT_EQ(response->status,
+            ledger::DBCommandResponse::Status::RESPONSE_OK);
+  ASSERT_TRUE(response->result && response->result->is_columns());
+
+  // NULL is read as the default value of the column type, like with ROWS
+  const auto& columns = response->result->get_columns();
+  EXPECT_EQ(columns->row_count, 2u);
+  ASSERT_EQ(columns->columns.size(), 5u);
+  EXPECT_EQ(columns->columns[0]->get_string_values(),
+            std::vector<std::string>({"brave", ""}));
+  EXPECT_EQ(columns->columns[1]->get_int_values(),
+            std::vector<int32_t>({-7, 0}));
+  EXPECT_EQ(columns->columns[2]->get_int64_values(),
+            std::vector<int64_t>({int64_t{8589934592}, 0}));
+  EXPECT_EQ(columns->columns[3]->get_double_values(),
+            std::vector<double>({1.5, 0.0}));
+  EXPECT_EQ(columns->columns[4]->get_bool_values(),
+            std::vector<bool>({true, false}));
+
+  // An empty result still has one typed column per binding
+  transaction = ledger::DBTransaction::New();
+  transaction->commands.push_back(CreateTypedColumnsRead(
+      "SELECT s, i, i64, d, b FROM typed WHERE 0"));
+  response = ledger::DBCommandResponse::New();
+  database_->RunTransaction(std::move(transaction), response.get());
+  ASSERT_TRUE(response->result && response->result->is_columns());
+
+  const auto& empty_columns = response->result->get_columns();
+  EXPECT_EQ(empty_columns->row_count, 0u);
+  ASSERT_EQ(empty_columns->columns.size(), 5u);
+  EXPECT_TRUE(empty_columns->columns[0]->get_string_values().empty());
+  EXPECT_TRUE(empty_columns->columns[1]->get_int_values().empty());
+  EXPECT_TRUE(empty_columns->columns[2]->get_int64_values().empty());
+  EXPECT_TRUE(empty_columns->columns[3]->get_double_values().empty());
+  EXPECT_TRUE(empty_columns->columns[4]->get_bool_values().empty());
+}
+
+}  // namespace brave_rewards
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
@@ -110,8 +111,20 @@ namespace {
 
 base::File g_diagnostic_log;
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kTailDiagnosticLogToNumLines = 20000;
-const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+const int64_t kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+// Size the log is cut down to once it grows past the maximum, so that
+// rotation rewrites a bounded amount of data and happens rarely
+const int64_t kDiagnosticLogRotatedFileSize = kDiagnosticLogMaxFileSize / 2;
+
+// Diagnostic log entries are buffered in memory and written to disk in
+// batches once either threshold is reached
+const size_t kDiagnosticLogMaxBufferedEntries = 100;
+constexpr base::TimeDelta kDiagnosticLogFlushDelay =
+    base::TimeDelta::FromSeconds(5);
+
+// Upper bound for the number of write-only DB transactions committed
+// together in a single SQLite transaction.
+const size_t kMaxCoalescedDBWrites = 100;
 
 ContentSite PublisherInfoToContentSite(
     const ledger::PublisherInfo& publisher_info) {
@@ -226,19 +239,47 @@ bool ResetOnFilesTaskRunner(const std::vector<base::FilePath>& paths) {
   return res;
 }
 
-std::string LoadDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& path,
-    const int num_lines) {
-  if (!base::PathExists(path)) {
-    return "";
+void TailStringToNumLines(
+    const int num_lines,
+    std::string* value) {
+  DCHECK(value);
+
+  if (num_lines == -1) {
+    return;
+  }
+
+  int line_count = 0;
+  for (size_t i = value->size(); i > 0; i--) {
+    if ((*value)[i - 1] != '\n') {
+      continue;
+    }
+
+    line_count++;
+    if (line_count == num_lines + 1) {
+      value->erase(0, i);
+      return;
+    }
   }
+}
 
+std::string LoadDiagnosticLogOnFileTaskRunner(
+    const base::FilePath& path,
+    const int num_lines,
+    const std::vector<DiagnosticLogEntry>& buffered_entries) {
   std::string value;
-  if (!TailFileAsString(&g_diagnostic_log, num_lines, &value)) {
+  if (base::PathExists(path) &&
+      !TailFileAsString(&g_diagnostic_log, num_lines, &value)) {
     return base::StringPrintf("ERROR: %s",
         GetLastFileError(&g_diagnostic_log).c_str());
   }
 
+  if (buffered_entries.empty()) {
+    return value;
+  }
+
+  value += FriendlyFormatLogEntries(buffered_entries);
+  TailStringToNumLines(num_lines, &value);
+
   return value;
 }
 
@@ -345,6 +386,39 @@ bool ProcessPublisher(const GURL& url) {
 
 const char pref_prefix[] = "brave.rewards.";
 
+// Prefs read by the ledger through Get*State, mirrored in the utility process
+const char* const kLedgerStatePrefs[] = {
+  prefs::kBraveRewardsEnabled,
+  prefs::kStateServerPublisherListStamp,
+  prefs::kStateUpholdAnonAddress,
+  prefs::kStatePromotionLastFetchStamp,
+  prefs::kStatePromotionCorruptedMigrated,
+  prefs::kStateAnonTransferChecked,
+  prefs::kStateVersion,
+  prefs::kStateMinVisitTime,
+  prefs::kStateMinVisits,
+  prefs::kStateAllowNonVerified,
+  prefs::kStateAllowVideoContribution,
+  prefs::kStateScoreA,
+  prefs::kStateScoreB,
+  prefs::kStateAutoContributeEnabled,
+  prefs::kStateAutoContributeAmount,
+  prefs::kStateNextReconcileStamp,
+  prefs::kStateCreationStamp,
+  prefs::kStateAnonymousCardId,
+  prefs::kStateRecoverySeed,
+  prefs::kStatePaymentId,
+  prefs::kStateInlineTipRedditEnabled,
+  prefs::kStateInlineTipTwitterEnabled,
+  prefs::kStateInlineTipGithubEnabled,
+  prefs::kStateParametersRate,
+  prefs::kStateParametersAutoContributeChoice,
+  prefs::kStateParametersAutoContributeChoices,
+  prefs::kStateParametersTipChoices,
+  prefs::kStateParametersMonthlyTipChoices,
+  prefs::kStateFetchOldBalance,
+};
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -483,12 +557,51 @@ void RewardsServiceImpl::StartLedger() {
   bat_ledger_service_->Create(std::move(client_ptr_info),
       MakeRequest(&bat_ledger_));
 
+  PushLedgerState();
+
   auto callback = base::BindOnce(&RewardsServiceImpl::OnWalletInitialized,
       AsWeakPtr());
 
   bat_ledger_->Initialize(false, std::move(callback));
 }
 
+void RewardsServiceImpl::PushLedgerState() {
+  PrefService* pref_service = profile_->GetPrefs();
+  ledger_state_registrar_.RemoveAll();
+  ledger_state_registrar_.Init(pref_service);
+
+  base::Value state(base::Value::Type::DICTIONARY);
+  for (const char* path : kLedgerStatePrefs) {
+    state.SetKey(
+        std::string(path).substr(strlen(pref_prefix)),
+        pref_service->Get(path)->Clone());
+    ledger_state_registrar_.Add(
+        path,
+        base::BindRepeating(&RewardsServiceImpl::OnLedgerStatePrefChanged,
+                            base::Unretained(this)));
+  }
+
+  std::string json;
+  base::JSONWriter::Write(state, &json);
+  bat_ledger_->OnStateChanged(json);
+}
+
+void RewardsServiceImpl::OnLedgerStatePrefChanged(const std::string& path) {
+  // Writes coming from the ledger are already applied to its mirror
+  if (writing_ledger_state_ || !Connected()) {
+    return;
+  }
+
+  base::Value state(base::Value::Type::DICTIONARY);
+  state.SetKey(
+      path.substr(strlen(pref_prefix)),
+      profile_->GetPrefs()->Get(path)->Clone());
+
+  std::string json;
+  base::JSONWriter::Write(state, &json);
+  bat_ledger_->OnStateChanged(json);
+}
+
 void RewardsServiceImpl::OnResult(
     ledger::ResultCallback callback,
     const ledger::Result result) {
@@ -795,6 +908,8 @@ std::string RewardsServiceImpl::URIEncode(const std::string& value) {
 }
 
 void RewardsServiceImpl::Shutdown() {
+  FlushDBWrites();
+  FlushDiagnosticLog();
   RemoveObserver(notification_service_.get());
 
   if (extension_observer_) {
@@ -1594,6 +1709,7 @@ void RewardsServiceImpl::OnLoadedState(
 }
 
 void RewardsServiceImpl::SetBooleanState(const std::string& name, bool value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetBoolean(pref_prefix + name, value);
 }
 
@@ -1602,6 +1718,7 @@ bool RewardsServiceImpl::GetBooleanState(const std::string& name) const {
 }
 
 void RewardsServiceImpl::SetIntegerState(const std::string& name, int value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetInteger(pref_prefix + name, value);
 }
 
@@ -1610,6 +1727,7 @@ int RewardsServiceImpl::GetIntegerState(const std::string& name) const {
 }
 
 void RewardsServiceImpl::SetDoubleState(const std::string& name, double value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetDouble(pref_prefix + name, value);
 }
 
@@ -1619,6 +1737,7 @@ double RewardsServiceImpl::GetDoubleState(const std::string& name) const {
 
 void RewardsServiceImpl::SetStringState(const std::string& name,
                                         const std::string& value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetString(pref_prefix + name, value);
 }
 
@@ -1627,6 +1746,7 @@ std::string RewardsServiceImpl::GetStringState(const std::string& name) const {
 }
 
 void RewardsServiceImpl::SetInt64State(const std::string& name, int64_t value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetInt64(pref_prefix + name, value);
 }
 
@@ -1636,6 +1756,7 @@ int64_t RewardsServiceImpl::GetInt64State(const std::string& name) const {
 
 void RewardsServiceImpl::SetUint64State(const std::string& name,
                                         uint64_t value) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->SetUint64(pref_prefix + name, value);
 }
 
@@ -1644,6 +1765,7 @@ uint64_t RewardsServiceImpl::GetUint64State(const std::string& name) const {
 }
 
 void RewardsServiceImpl::ClearState(const std::string& name) {
+  base::AutoReset<bool> writing(&writing_ledger_state_, true);
   profile_->GetPrefs()->ClearPref(pref_prefix + name);
 }
 
@@ -2328,39 +2450,26 @@ void RewardsServiceImpl::ShowNotificationTipsPaid(bool ac_enabled) {
       "rewards_notification_tips_processed");
 }
 
-bool MaybeTailDiagnosticLog(
-    const int num_lines) {
+bool MaybeRotateDiagnosticLog() {
   if (!g_diagnostic_log.IsValid()) {
     return false;
   }
 
-  static bool first_run = true;
-
   const int64_t length = g_diagnostic_log.GetLength();
   if (length == -1) {
     return false;
   }
 
-  if (!first_run && length <= kDiagnosticLogMaxFileSize) {
+  if (length <= kDiagnosticLogMaxFileSize) {
     return true;
   }
 
-  first_run = false;
-
-  if (!TailFile(&g_diagnostic_log, num_lines)) {
-    return false;
-  }
-
-  return true;
+  return TailFileToSize(&g_diagnostic_log, kDiagnosticLogRotatedFileSize);
 }
 
 bool WriteToDiagnosticLogOnFileTaskRunner(
     const base::FilePath& log_path,
-    const int num_lines,
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
+    const std::vector<DiagnosticLogEntry>& entries) {
   if (!InitializeLog(&g_diagnostic_log, log_path)) {
     VLOG(0) << "Failed to initialize diagnostic log: "
         << GetLastFileError(&g_diagnostic_log);
@@ -2368,20 +2477,17 @@ bool WriteToDiagnosticLogOnFileTaskRunner(
     return false;
   }
 
-  const base::Time time = base::Time::Now();
+  const std::string log_entries = FriendlyFormatLogEntries(entries);
 
-  const std::string log_entry =
-      FriendlyFormatLogEntry(time, file, line, verbose_level, message);
-
-  if (!WriteToLog(&g_diagnostic_log, log_entry)) {
+  if (!WriteToLog(&g_diagnostic_log, log_entries)) {
     VLOG(0) << "Failed to write to diagnostic log: "
         << GetLastFileError(&g_diagnostic_log);
 
     return false;
   }
 
-  if (!MaybeTailDiagnosticLog(num_lines)) {
-    VLOG(0) << "Failed to vacuum diagnostic log";
+  if (!MaybeRotateDiagnosticLog()) {
+    VLOG(0) << "Failed to rotate diagnostic log";
 
     return false;
   }
@@ -2402,10 +2508,38 @@ void RewardsServiceImpl::DiagnosticLog(
     return;
   }
 
+  DiagnosticLogEntry entry;
+  entry.time = base::Time::Now();
+  entry.file = file;
+  entry.line = line;
+  entry.verbose_level = verbose_level;
+  entry.message = message;
+  diagnostic_log_entries_.push_back(entry);
+
+  if (diagnostic_log_entries_.size() >= kDiagnosticLogMaxBufferedEntries) {
+    FlushDiagnosticLog();
+    return;
+  }
+
+  if (!diagnostic_log_timer_.IsRunning()) {
+    diagnostic_log_timer_.Start(FROM_HERE, kDiagnosticLogFlushDelay, this,
+        &RewardsServiceImpl::FlushDiagnosticLog);
+  }
+}
+
+void RewardsServiceImpl::FlushDiagnosticLog() {
+  diagnostic_log_timer_.Stop();
+
+  if (diagnostic_log_entries_.empty()) {
+    return;
+  }
+
+  std::vector<DiagnosticLogEntry> entries;
+  entries.swap(diagnostic_log_entries_);
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&WriteToDiagnosticLogOnFileTaskRunner,
-          diagnostic_log_path_, kTailDiagnosticLogToNumLines, file, line,
-              verbose_level, message),
+          diagnostic_log_path_, std::move(entries)),
       base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
           AsWeakPtr()));
 }
@@ -2420,7 +2554,7 @@ void RewardsServiceImpl::LoadDiagnosticLog(
       LoadDiagnosticLogCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadDiagnosticLogOnFileTaskRunner, diagnostic_log_path_,
-          num_lines),
+          num_lines, diagnostic_log_entries_),
       base::BindOnce(&RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner,
           AsWeakPtr(),
           std::move(callback)));
@@ -2434,6 +2568,9 @@ void RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner(
 
 void RewardsServiceImpl::ClearDiagnosticLog(
     ClearDiagnosticLogCallback callback) {
+  diagnostic_log_timer_.Stop();
+  diagnostic_log_entries_.clear();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ClearDiagnosticLogOnFileTaskRunner, diagnostic_log_path_),
       base::BindOnce(&RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner,
@@ -3505,9 +3642,48 @@ ledger::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
   return response;
 }
 
+std::vector<ledger::DBCommandResponsePtr>
+RunDBWriteTransactionsOnFileTaskRunner(
+    std::vector<ledger::DBTransactionPtr> transactions,
+    RewardsDatabase* backend) {
+  if (!backend) {
+    std::vector<ledger::DBCommandResponsePtr> responses;
+    for (size_t i = 0; i < transactions.size(); i++) {
+      auto response = ledger::DBCommandResponse::New();
+      response->status = ledger::DBCommandResponse::Status::RESPONSE_ERROR;
+      responses.push_back(std::move(response));
+    }
+    return responses;
+  }
+
+  return backend->RunWriteTransactions(std::move(transactions));
+}
+
 void RewardsServiceImpl::RunDBTransaction(
     ledger::DBTransactionPtr transaction,
     ledger::RunDBTransactionCallback callback) {
+  if (transaction &&
+      RewardsDatabase::IsWriteOnlyTransaction(*transaction)) {
+    // Writes are committed in groups: while a batch is being committed,
+    // new writes wait for it to finish and then go out together. When idle,
+    // the flush runs after the tasks already queued, so a burst of writes
+    // arriving back to back shares a single commit.
+    pending_db_write_transactions_.push_back(std::move(transaction));
+    pending_db_write_callbacks_.push_back(std::move(callback));
+    if (pending_db_write_transactions_.size() >= kMaxCoalescedDBWrites) {
+      FlushDBWrites();
+    } else if (db_write_batches_in_flight_ == 0 &&
+               !db_write_timer_.IsRunning()) {
+      db_write_timer_.Start(FROM_HERE, base::TimeDelta(), this,
+          &RewardsServiceImpl::FlushDBWrites);
+    }
+    return;
+  }
+
+  // Reads and schema changes must observe every write queued before them,
+  // and |file_task_runner_| is sequenced, so post pending writes first.
+  FlushDBWrites();
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
@@ -3525,6 +3701,45 @@ void RewardsServiceImpl::OnRunDBTransaction(
   callback(std::move(response));
 }
 
+void RewardsServiceImpl::FlushDBWrites() {
+  db_write_timer_.Stop();
+  if (pending_db_write_transactions_.empty()) {
+    return;
+  }
+
+  std::vector<ledger::DBTransactionPtr> transactions;
+  transactions.swap(pending_db_write_transactions_);
+  std::vector<ledger::RunDBTransactionCallback> callbacks;
+  callbacks.swap(pending_db_write_callbacks_);
+
+  db_write_batches_in_flight_++;
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(),
+      FROM_HERE,
+      base::BindOnce(&RunDBWriteTransactionsOnFileTaskRunner,
+          std::move(transactions),
+          rewards_database_.get()),
+      base::BindOnce(&RewardsServiceImpl::OnRunDBWriteTransactions,
+          AsWeakPtr(),
+          std::move(callbacks)));
+}
+
+void RewardsServiceImpl::OnRunDBWriteTransactions(
+    std::vector<ledger::RunDBTransactionCallback> callbacks,
+    std::vector<ledger::DBCommandResponsePtr> responses) {
+  DCHECK_GT(db_write_batches_in_flight_, 0u);
+  db_write_batches_in_flight_--;
+
+  DCHECK_EQ(callbacks.size(), responses.size());
+  for (size_t i = 0; i < callbacks.size() && i < responses.size(); i++) {
+    callbacks[i](std::move(responses[i]));
+  }
+
+  if (db_write_batches_in_flight_ == 0) {
+    FlushDBWrites();
+  }
+}
+
 void RewardsServiceImpl::GetCreateScript(
     ledger::GetCreateScriptCallback callback) {
   callback("", 0);
@@ -19,17 +19,20 @@
 #include "base/files/file.h"
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
+#include "base/timer/timer.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/associated_binding.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "brave/components/brave_rewards/browser/balance_report.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
+#include "brave/components/brave_rewards/browser/logging_util.h"
 #include "ui/gfx/image/image.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
@@ -528,6 +531,9 @@ class RewardsServiceImpl : public RewardsService,
       const int verbose_level,
       const std::string& message) override;
 
+  // Writes buffered diagnostic log entries to disk
+  void FlushDiagnosticLog();
+
   void OnWriteToLogOnFileTaskRunner(
     const bool success);
 
@@ -650,6 +656,11 @@ class RewardsServiceImpl : public RewardsService,
 
   bool Connected() const;
   void ConnectionClosed();
+
+  // Sends the ledger state prefs to the utility process and keeps them
+  // current when they are changed outside of the ledger
+  void PushLedgerState();
+  void OnLedgerStatePrefChanged(const std::string& path);
   void AddPrivateObserver(RewardsServicePrivateObserver* observer) override;
   void RemovePrivateObserver(RewardsServicePrivateObserver* observer) override;
 
@@ -679,6 +690,13 @@ class RewardsServiceImpl : public RewardsService,
       ledger::RunDBTransactionCallback callback,
       ledger::DBCommandResponsePtr response);
 
+  // Commits all queued write-only transactions in one batch.
+  void FlushDBWrites();
+
+  void OnRunDBWriteTransactions(
+      std::vector<ledger::RunDBTransactionCallback> callbacks,
+      std::vector<ledger::DBCommandResponsePtr> responses);
+
   void OnGetAllMonthlyReportIds(
       GetAllMonthlyReportIdsCallback callback,
       const std::vector<std::string>& ids);
@@ -714,12 +732,18 @@ class RewardsServiceImpl : public RewardsService,
   mojo::Remote<bat_ledger::mojom::BatLedgerService> bat_ledger_service_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   const base::FilePath diagnostic_log_path_;
+  std::vector<DiagnosticLogEntry> diagnostic_log_entries_;
+  base::OneShotTimer diagnostic_log_timer_;
   const base::FilePath ledger_state_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
   const base::FilePath publisher_list_path_;
   const base::FilePath rewards_base_path_;
   std::unique_ptr<RewardsDatabase> rewards_database_;
+  std::vector<ledger::DBTransactionPtr> pending_db_write_transactions_;
+  std::vector<ledger::RunDBTransactionCallback> pending_db_write_callbacks_;
+  base::OneShotTimer db_write_timer_;
+  size_t db_write_batches_in_flight_ = 0;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
   std::unique_ptr<RewardsServiceObserver> extension_observer_;
@@ -739,6 +763,9 @@ class RewardsServiceImpl : public RewardsService,
 
   GetTestResponseCallback test_response_callback_;
 
+  PrefChangeRegistrar ledger_state_registrar_;
+  bool writing_ledger_state_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(RewardsServiceImpl);
 };
 
@@ -428,6 +428,11 @@ bool NTPBackgroundImagesService::HasObserver(Observer* observer) {
   return observer_list_.HasObserver(observer);
 }
 
+base::WeakPtr<NTPBackgroundImagesService>
+NTPBackgroundImagesService::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
 NTPBackgroundImagesData*
 NTPBackgroundImagesService::GetBackgroundImagesData(bool super_referral) const {
   const bool is_sr_enabled =
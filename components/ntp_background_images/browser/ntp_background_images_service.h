@@ -59,6 +59,8 @@ class NTPBackgroundImagesService {
   void RemoveObserver(Observer* observer);
   bool HasObserver(Observer* observer);
 
+  base::WeakPtr<NTPBackgroundImagesService> GetWeakPtr();
+
   NTPBackgroundImagesData* GetBackgroundImagesData(bool super_referral) const;
 
   bool test_data_used() const { return test_data_used_; }
@@ -12,6 +12,7 @@
 #include "base/files/file_util.h"
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
+#include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
@@ -34,15 +35,23 @@ bool IsSuperReferralPath(const std::string& path) {
   return path.rfind(kSuperReferralPath, 0) == 0;
 }
 
+// Enough for the logo and wallpapers of both sponsored images and super
+// referral components plus top site favicons.
+constexpr size_t kMaximumImageCacheSize = 32 * 1024 * 1024;
+
 }  // namespace
 
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
-    : service_(service),
+    : service_(service->GetWeakPtr()),
       weak_factory_(this) {
+  service_->AddObserver(this);
 }
 
-NTPBackgroundImagesSource::~NTPBackgroundImagesSource() = default;
+NTPBackgroundImagesSource::~NTPBackgroundImagesSource() {
+  if (service_)
+    service_->RemoveObserver(this);
+}
 
 std::string NTPBackgroundImagesSource::GetSource() {
   return kBrandedWallpaperHost;
@@ -55,7 +64,7 @@ void NTPBackgroundImagesSource::StartDataRequest(
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   const std::string path = URLDataSource::URLToRequestPath(url);
-  if (!IsValidPath(path)) {
+  if (!service_ || !IsValidPath(path)) {
     scoped_refptr<base::RefCountedMemory> bytes;
     std::move(callback).Run(std::move(bytes));
     return;
@@ -91,23 +100,39 @@ void NTPBackgroundImagesSource::StartDataRequest(
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  const auto iter = image_cache_.find(image_file_path);
+  if (iter != image_cache_.end()) {
+    std::move(callback).Run(iter->second);
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(&ReadFileToString, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
                      weak_factory_.GetWeakPtr(),
+                     image_file_path,
                      std::move(callback)));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
+    const base::FilePath& image_file_path,
     GotDataCallback callback,
     base::Optional<std::string> input) {
   if (!input)
     return;
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
+  scoped_refptr<base::RefCountedMemory> bytes =
+      base::RefCountedString::TakeString(&input.value());
+
+  // Files of the current components don't change until a new component is
+  // reported, so keep them in memory unless the cache is full.
+  if (!base::Contains(image_cache_, image_file_path) &&
+      image_cache_size_ + bytes->size() <= kMaximumImageCacheSize) {
+    image_cache_[image_file_path] = bytes;
+    image_cache_size_ += bytes->size();
+  }
+
   std::move(callback).Run(std::move(bytes));
 }
 
@@ -121,6 +146,16 @@ bool NTPBackgroundImagesSource::AllowCaching() {
   return false;
 }
 
+void NTPBackgroundImagesSource::OnUpdated(NTPBackgroundImagesData* data) {
+  image_cache_.clear();
+  image_cache_size_ = 0;
+}
+
+void NTPBackgroundImagesSource::OnSuperReferralEnded() {
+  image_cache_.clear();
+  image_cache_size_ = 0;
+}
+
 bool NTPBackgroundImagesSource::IsValidPath(const std::string& path) const {
   if (IsLogoPath(path))
     return true;
@@ -6,22 +6,21 @@
 #ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 
+#include <map>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/optional.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "content/public/browser/url_data_source.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace ntp_background_images {
 
-class NTPBackgroundImagesService;
-
 // This serves background image data.
-class NTPBackgroundImagesSource : public content::URLDataSource {
+class NTPBackgroundImagesSource : public content::URLDataSource,
+                                  public NTPBackgroundImagesService::Observer {
  public:
   explicit NTPBackgroundImagesSource(NTPBackgroundImagesService* service);
 
@@ -35,6 +34,10 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
+                           ImageCacheIsClearedWhenComponentIsUpdated);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
+                           ServiceDestroyedBeforeSource);
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -44,9 +47,14 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   std::string GetMimeType(const std::string& path) override;
   bool AllowCaching() override;
 
+  // NTPBackgroundImagesService::Observer overrides:
+  void OnUpdated(NTPBackgroundImagesData* data) override;
+  void OnSuperReferralEnded() override;
+
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      GotDataCallback callback,
                       base::Optional<std::string> input);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
@@ -55,7 +63,15 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   bool IsTopSiteFaviconPath(const std::string& path) const;
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
-  NTPBackgroundImagesService* service_;  // not owned
+  // The service is owned by the browser process and can be destroyed before
+  // this profile's data sources.
+  base::WeakPtr<NTPBackgroundImagesService> service_;
+
+  // Image bytes of the current components keyed by file path, so that new tabs
+  // opened after the first one are served without reading from disk. Cleared
+  // whenever the service reports a new component.
+  std::map<base::FilePath, scoped_refptr<base::RefCountedMemory>> image_cache_;
+  size_t image_cache_size_ = 0;
   base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
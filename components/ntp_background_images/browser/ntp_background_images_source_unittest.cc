@@ -6,6 +6,9 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -79,6 +82,38 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest,
+       ImageCacheIsClearedWhenComponentIsUpdated) {
+  const base::FilePath image_file_path =
+      base::FilePath::FromUTF8Unsafe("logo.png");
+  source_->OnGotImageFile(image_file_path, base::DoNothing(),
+                          std::string("image data"));
+  EXPECT_EQ(1UL, source_->image_cache_.size());
+
+  scoped_refptr<base::RefCountedMemory> cached_bytes;
+  source_->GetImageFile(
+      image_file_path,
+      base::BindOnce([](scoped_refptr<base::RefCountedMemory>* cached_bytes,
+                        scoped_refptr<base::RefCountedMemory> bytes) {
+                       *cached_bytes = bytes;
+                     },
+                     &cached_bytes));
+  ASSERT_TRUE(cached_bytes);
+  EXPECT_EQ("image data", std::string(cached_bytes->front_as<char>(),
+                                      cached_bytes->size()));
+
+  service_->OnGetComponentJsonData(false, "{}");
+  EXPECT_TRUE(source_->image_cache_.empty());
+}
+
+TEST_F(NTPBackgroundImagesSourceTest, ServiceDestroyedBeforeSource) {
+  // The service is a browser-wide singleton and can go away before the data
+  // sources of a profile.
+  service_.reset();
+  EXPECT_FALSE(source_->service_);
+  source_.reset();
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
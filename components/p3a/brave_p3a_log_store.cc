@@ -20,6 +20,10 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Histograms tend to be updated in bursts, so batch them into one pref write
+// made this long after the first change of the batch.
+constexpr base::TimeDelta kPersistDelay = base::TimeDelta::FromSeconds(30);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -56,27 +60,18 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  MarkAsDirty(histogram_name);
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      MarkAsDirty(pair.first);
     }
   }
 
@@ -137,13 +132,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
   auto log_iter = log_.find(staged_entry_key_);
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  MarkAsDirty(log_iter->first);
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -154,6 +143,34 @@ void BraveP3ALogStore::DiscardStagedLog() {
   staged_log_.clear();
 }
 
+void BraveP3ALogStore::PersistPendingUpdates() {
+  persist_timer_.Stop();
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& name : dirty_entries_) {
+    auto iter = log_.find(name);
+    DCHECK(iter != log_.end());
+    const LogEntry& entry = iter->second;
+    update->SetPath({name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  dirty_entries_.clear();
+}
+
+void BraveP3ALogStore::MarkAsDirty(const std::string& histogram_name) {
+  dirty_entries_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, kPersistDelay, this,
+                         &BraveP3ALogStore::PersistPendingUpdates);
+  }
+}
+
 void BraveP3ALogStore::PersistUnsentLogs() const {
   NOTREACHED();
 }
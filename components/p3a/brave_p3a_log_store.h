@@ -12,6 +12,7 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,10 +20,20 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs in batches.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
+//
+// Changed entries are only marked as dirty and are written to the pref in a
+// single update a fixed |kPersistDelay| after the first unpersisted change
+// (later changes do not push the write back), or when
+// |PersistPendingUpdates()| is called. The owner must call it at shutdown
+// while local state is still alive: the destructor does not write, since the
+// refcounted service owning the store may outlive local state. A crash
+// therefore loses at most the changes made during the last delay window: lost
+// values are re-recorded by their histograms, and a lost "sent" stamp can
+// only cause an entry to be uploaded once more within the same rotation.
 class BraveP3ALogStore : public metrics::LogStore {
  public:
   class Delegate {
@@ -47,6 +58,9 @@ class BraveP3ALogStore : public metrics::LogStore {
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
+  // Writes all pending changes to the pref immediately.
+  void PersistPendingUpdates();
+
   // metrics::LogStore:
   bool has_unsent_logs() const override;
   bool has_staged_log() const override;
@@ -56,8 +70,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   void StageNextLog() override;
   void DiscardStagedLog() override;
 
-  // |PersistUnsentLogs| should not be used, since we persist everything
-  // on the fly.
+  // |PersistUnsentLogs| should not be used, since changes are persisted by
+  // |PersistPendingUpdates()|.
   void PersistUnsentLogs() const override;
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
@@ -80,12 +94,18 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Schedules |histogram_name| to be written by the next persist.
+  void MarkAsDirty(const std::string& histogram_name);
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
+  // Entries changed since the last persist.
+  base::flat_set<std::string> dirty_entries_;
+  base::OneShotTimer persist_timer_;
 
   std::string staged_entry_key_;
   std::string staged_log_;
@@ -0,0 +1,125 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+constexpr char kHistogramName[] = "Brave.P3A.Test";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public ::testing::Test {
+ public:
+  BraveP3ALogStoreTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+    BraveP3ALogStore::RegisterPrefs(pref_service_.registry());
+    registrar_.Init(&pref_service_);
+    registrar_.Add(kPrefName,
+                   base::BindRepeating(&BraveP3ALogStoreTest::OnPrefChanged,
+                                       base::Unretained(this)));
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &pref_service_);
+    log_store_->LoadPersistedUnsentLogs();
+    pref_writes_ = 0;
+  }
+
+ protected:
+  void OnPrefChanged() { ++pref_writes_; }
+
+  const base::Value* GetPersistedValue() const {
+    return pref_service_.GetDictionary(kPrefName)
+        ->FindPath({kHistogramName, "value"});
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple pref_service_;
+  PrefChangeRegistrar registrar_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+  int pref_writes_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, CoalescesUpdatesIntoOnePrefWrite) {
+  for (uint64_t value = 0; value < 100; ++value) {
+    log_store_->UpdateValue(kHistogramName, value);
+  }
+  EXPECT_EQ(0, pref_writes_);
+  EXPECT_EQ(nullptr, GetPersistedValue());
+
+  task_environment_.FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_writes_);
+  ASSERT_NE(nullptr, GetPersistedValue());
+  EXPECT_EQ("99", GetPersistedValue()->GetString());
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsPendingUpdatesOnDemand) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+
+  log_store_->PersistPendingUpdates();
+  EXPECT_EQ(1, pref_writes_);
+  ASSERT_NE(nullptr, GetPersistedValue());
+  EXPECT_EQ("1", GetPersistedValue()->GetString());
+
+  // Nothing is left to write by the timer.
+  task_environment_.FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_writes_);
+
+  // Persisted state survives a restart.
+  log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &pref_service_);
+  log_store_->LoadPersistedUnsentLogs();
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsAfterFixedDelay) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(20));
+  // A later change does not postpone the write.
+  log_store_->UpdateValue(kHistogramName, 2);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+
+  EXPECT_EQ(1, pref_writes_);
+  ASSERT_NE(nullptr, GetPersistedValue());
+  EXPECT_EQ("2", GetPersistedValue()->GetString());
+}
+
+TEST_F(BraveP3ALogStoreTest, DoesNotPersistOnDestruction) {
+  // The store may be destroyed after local state at shutdown.
+  log_store_->UpdateValue(kHistogramName, 2);
+  log_store_.reset();
+
+  EXPECT_EQ(0, pref_writes_);
+  EXPECT_EQ(nullptr, GetPersistedValue());
+}
+
+}  // namespace brave
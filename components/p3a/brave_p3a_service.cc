@@ -183,6 +183,12 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::PersistPendingLogs() {
+  if (log_store_) {
+    log_store_->PersistPendingUpdates();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) const {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
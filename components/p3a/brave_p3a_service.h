@@ -47,6 +47,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes log changes that are still pending to local state. Should be
+  // called before local state is committed at shutdown.
+  void PersistPendingLogs();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) const override;
@@ -10,7 +10,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/base/containers/utils.h"
 
 namespace bat_ledger {
@@ -36,7 +38,9 @@ void OnGetExternalWallets(
 }  // namespace
 
 BatLedgerClientMojoProxy::BatLedgerClientMojoProxy(
-    mojom::BatLedgerClientAssociatedPtrInfo client_info) {
+    mojom::BatLedgerClientAssociatedPtrInfo client_info)
+    : state_(base::Value::Type::DICTIONARY),
+      options_(base::Value::Type::DICTIONARY) {
   bat_ledger_client_.Bind(std::move(client_info));
 }
 
@@ -255,115 +259,220 @@ void BatLedgerClientMojoProxy::ResetState(
       name, base::BindOnce(&OnResultCallback, std::move(callback)));
 }
 
+void BatLedgerClientMojoProxy::OnStateChanged(const std::string& json) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_dict()) {
+    return;
+  }
+
+  for (auto item : value->DictItems()) {
+    state_.SetKey(item.first, std::move(item.second));
+  }
+}
+
 void BatLedgerClientMojoProxy::SetBooleanState(const std::string& name,
                                                bool value) {
+  state_.SetBoolKey(name, value);
   bat_ledger_client_->SetBooleanState(name, value);
 }
 
 bool BatLedgerClientMojoProxy::GetBooleanState(const std::string& name) const {
-  bool value;
-  bat_ledger_client_->GetBooleanState(name, &value);
+  const base::Optional<bool> cached = state_.FindBoolKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  bool value = false;
+  if (bat_ledger_client_->GetBooleanState(name, &value)) {
+    state_.SetBoolKey(name, value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoProxy::SetIntegerState(const std::string& name,
                                                int value) {
+  state_.SetIntKey(name, value);
   bat_ledger_client_->SetIntegerState(name, value);
 }
 
 int BatLedgerClientMojoProxy::GetIntegerState(const std::string& name) const {
-  int value;
-  bat_ledger_client_->GetIntegerState(name, &value);
+  const base::Optional<int> cached = state_.FindIntKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  int value = 0;
+  if (bat_ledger_client_->GetIntegerState(name, &value)) {
+    state_.SetIntKey(name, value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoProxy::SetDoubleState(const std::string& name,
                                               double value) {
+  state_.SetDoubleKey(name, value);
   bat_ledger_client_->SetDoubleState(name, value);
 }
 
 double BatLedgerClientMojoProxy::GetDoubleState(const std::string& name) const {
-  double value;
-  bat_ledger_client_->GetDoubleState(name, &value);
+  const base::Optional<double> cached = state_.FindDoubleKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  double value = 0.0;
+  if (bat_ledger_client_->GetDoubleState(name, &value)) {
+    state_.SetDoubleKey(name, value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoProxy::SetStringState(const std::string& name,
                               const std::string& value) {
+  state_.SetStringKey(name, value);
   bat_ledger_client_->SetStringState(name, value);
 }
 
 std::string BatLedgerClientMojoProxy::
 GetStringState(const std::string& name) const {
+  const std::string* cached = state_.FindStringKey(name);
+  if (cached) {
+    return *cached;
+  }
+
   std::string value;
-  bat_ledger_client_->GetStringState(name, &value);
+  if (bat_ledger_client_->GetStringState(name, &value)) {
+    state_.SetStringKey(name, value);
+  }
   return value;
 }
 
+// 64-bit values are mirrored as strings, the same way prefs store them
 void BatLedgerClientMojoProxy::SetInt64State(const std::string& name,
                                              int64_t value) {
+  state_.SetStringKey(name, base::NumberToString(value));
   bat_ledger_client_->SetInt64State(name, value);
 }
 
 int64_t BatLedgerClientMojoProxy::GetInt64State(const std::string& name) const {
-  int64_t value;
-  bat_ledger_client_->GetInt64State(name, &value);
+  const std::string* cached = state_.FindStringKey(name);
+  int64_t value = 0;
+  if (cached && base::StringToInt64(*cached, &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetInt64State(name, &value)) {
+    state_.SetStringKey(name, base::NumberToString(value));
+  }
   return value;
 }
 
 void BatLedgerClientMojoProxy::SetUint64State(const std::string& name,
                                               uint64_t value) {
+  state_.SetStringKey(name, base::NumberToString(value));
   bat_ledger_client_->SetUint64State(name, value);
 }
 
 uint64_t BatLedgerClientMojoProxy::GetUint64State(
     const std::string& name) const {
-  uint64_t value;
-  bat_ledger_client_->GetUint64State(name, &value);
+  const std::string* cached = state_.FindStringKey(name);
+  uint64_t value = 0;
+  if (cached && base::StringToUint64(*cached, &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetUint64State(name, &value)) {
+    state_.SetStringKey(name, base::NumberToString(value));
+  }
   return value;
 }
 
 void BatLedgerClientMojoProxy::ClearState(const std::string& name) {
+  // The default value is only known to the client, read it again on demand
+  state_.RemoveKey(name);
   bat_ledger_client_->ClearState(name);
 }
 
+// Options are constant for the lifetime of the client
 bool BatLedgerClientMojoProxy::GetBooleanOption(const std::string& name) const {
-  bool value;
-  bat_ledger_client_->GetBooleanOption(name, &value);
+  const base::Optional<bool> cached = options_.FindBoolKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  bool value = false;
+  if (bat_ledger_client_->GetBooleanOption(name, &value)) {
+    options_.SetBoolKey(name, value);
+  }
   return value;
 }
 
 int BatLedgerClientMojoProxy::GetIntegerOption(const std::string& name) const {
-  int value;
-  bat_ledger_client_->GetIntegerOption(name, &value);
+  const base::Optional<int> cached = options_.FindIntKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  int value = 0;
+  if (bat_ledger_client_->GetIntegerOption(name, &value)) {
+    options_.SetIntKey(name, value);
+  }
   return value;
 }
 
 double BatLedgerClientMojoProxy::GetDoubleOption(
     const std::string& name) const {
-  double value;
-  bat_ledger_client_->GetDoubleOption(name, &value);
+  const base::Optional<double> cached = options_.FindDoubleKey(name);
+  if (cached) {
+    return *cached;
+  }
+
+  double value = 0.0;
+  if (bat_ledger_client_->GetDoubleOption(name, &value)) {
+    options_.SetDoubleKey(name, value);
+  }
   return value;
 }
 
 std::string BatLedgerClientMojoProxy::GetStringOption(
     const std::string& name) const {
+  const std::string* cached = options_.FindStringKey(name);
+  if (cached) {
+    return *cached;
+  }
+
   std::string value;
-  bat_ledger_client_->GetStringOption(name, &value);
+  if (bat_ledger_client_->GetStringOption(name, &value)) {
+    options_.SetStringKey(name, value);
+  }
   return value;
 }
 
 int64_t BatLedgerClientMojoProxy::GetInt64Option(
     const std::string& name) const {
-  int64_t value;
-  bat_ledger_client_->GetInt64Option(name, &value);
+  const std::string* cached = options_.FindStringKey(name);
+  int64_t value = 0;
+  if (cached && base::StringToInt64(*cached, &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetInt64Option(name, &value)) {
+    options_.SetStringKey(name, base::NumberToString(value));
+  }
   return value;
 }
 
 uint64_t BatLedgerClientMojoProxy::GetUint64Option(
     const std::string& name) const {
-  uint64_t value;
-  bat_ledger_client_->GetUint64Option(name, &value);
+  const std::string* cached = options_.FindStringKey(name);
+  uint64_t value = 0;
+  if (cached && base::StringToUint64(*cached, &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetUint64Option(name, &value)) {
+    options_.SetStringKey(name, base::NumberToString(value));
+  }
   return value;
 }
 
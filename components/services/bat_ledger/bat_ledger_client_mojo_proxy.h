@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
@@ -66,6 +67,10 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
                  ledger::OnLoadCallback callback) override;
   void ResetState(const std::string& name,
                   ledger::ResultCallback callback) override;
+  // Merges |json|, a dictionary of state values keyed by name, into the
+  // local mirror
+  void OnStateChanged(const std::string& json);
+
   void SetBooleanState(const std::string& name, bool value) override;
   bool GetBooleanState(const std::string& name) const override;
   void SetIntegerState(const std::string& name, int value) override;
@@ -141,6 +146,12 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
 
   mojom::BatLedgerClientAssociatedPtr bat_ledger_client_;
 
+  // Process-local mirror of the client state and options, so that reads
+  // don't block on a sync call to the browser. State is pushed by the
+  // browser, filled on first read and kept current by ledger writes.
+  mutable base::Value state_;
+  mutable base::Value options_;
+
   void OnLoadLedgerState(ledger::OnLoadCallback callback,
       const ledger::Result result, const std::string& data);
   void OnLoadPublisherState(ledger::OnLoadCallback callback,
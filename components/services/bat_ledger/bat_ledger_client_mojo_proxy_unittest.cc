@@ -0,0 +1,210 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_proxy.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/json/json_writer.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "bat/ledger/internal/ledger_client_mock.h"
+#include "bat/ledger/internal/ledger_impl.h"
+#include "bat/ledger/internal/state/state_keys.h"
+#include "bat/ledger/option_keys.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
+#include "mojo/public/cpp/bindings/associated_binding.h"
+#include "mojo/public/cpp/bindings/associated_interface_request.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoProxyTest.*
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+namespace bat_ledger {
+
+class BatLedgerClientMojoProxyTest : public testing::Test {
+ protected:
+  BatLedgerClientMojoProxyTest()
+      : ledger_client_mojo_proxy_(&mock_ledger_client_),
+        binding_(&ledger_client_mojo_proxy_) {
+    mojom::BatLedgerClientAssociatedPtr client;
+    binding_.Bind(mojo::MakeRequestAssociatedWithDedicatedPipe(&client));
+    proxy_ = std::make_unique<BatLedgerClientMojoProxy>(
+        client.PassInterface());
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  ledger::MockLedgerClient mock_ledger_client_;
+  LedgerClientMojoProxy ledger_client_mojo_proxy_;
+  mojo::AssociatedBinding<mojom::BatLedgerClient> binding_;
+  std::unique_ptr<BatLedgerClientMojoProxy> proxy_;
+};
+
+TEST_F(BatLedgerClientMojoProxyTest, VisitBurstPerformsNoSyncCalls) {
+  EXPECT_CALL(mock_ledger_client_, GetBooleanState(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetIntegerState(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetDoubleState(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetStringState(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetInt64State(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetUint64State(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetBooleanOption(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetIntegerOption(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetDoubleOption(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetStringOption(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetInt64Option(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetUint64Option(_)).Times(0);
+
+  // Every record lookup comes back empty, so each visit goes through the
+  // whole save path for a new publisher
+  int transaction_count = 0;
+  ON_CALL(mock_ledger_client_, RunDBTransaction(_, _))
+      .WillByDefault(
+          Invoke([&transaction_count](
+              ledger::DBTransactionPtr transaction,
+              ledger::RunDBTransactionCallback callback) {
+            transaction_count++;
+            auto response = ledger::DBCommandResponse::New();
+            response->status = ledger::DBCommandResponse::Status::RESPONSE_OK;
+            response->result = ledger::DBCommandResult::New();
+            response->result->set_records(std::vector<ledger::DBRecordPtr>());
+            callback(std::move(response));
+          }));
+
+  // The browser pushes the whole ledger state when the utility process
+  // starts, see RewardsServiceImpl::PushLedgerState
+  const uint64_t now = static_cast<uint64_t>(base::Time::Now().ToDoubleT());
+  base::Value state(base::Value::Type::DICTIONARY);
+  state.SetBoolKey(ledger::kStateEnabled, true);
+  state.SetStringKey(ledger::kStateServerPublisherListStamp,
+                     base::NumberToString(now));
+  state.SetStringKey(ledger::kStateUpholdAnonAddress, "");
+  state.SetStringKey(ledger::kStatePromotionLastFetchStamp,
+                     base::NumberToString(now));
+  state.SetBoolKey(ledger::kStatePromotionCorruptedMigrated, true);
+  state.SetBoolKey(ledger::kStateAnonTransferChecked, true);
+  state.SetIntKey(ledger::kStateVersion, 1);
+  state.SetIntKey(ledger::kStateMinVisitTime, 8);
+  state.SetIntKey(ledger::kStateMinVisits, 1);
+  state.SetBoolKey(ledger::kStateAllowNonVerified, true);
+  state.SetBoolKey(ledger::kStateAllowVideoContribution, true);
+  state.SetDoubleKey(ledger::kStateScoreA, 14500.0);
+  state.SetDoubleKey(ledger::kStateScoreB, -14000.0);
+  state.SetBoolKey(ledger::kStateAutoContributeEnabled, true);
+  state.SetDoubleKey(ledger::kStateAutoContributeAmount, 20.0);
+  state.SetStringKey(ledger::kStateNextReconcileStamp,
+                     base::NumberToString(now + 30 * 24 * 60 * 60));
+  state.SetStringKey(ledger::kStateCreationStamp, base::NumberToString(now));
+  state.SetStringKey(ledger::kStateAnonymousCardId, "");
+  state.SetStringKey(ledger::kStateRecoverySeed, "");
+  state.SetStringKey(ledger::kStatePaymentId, "");
+  state.SetBoolKey(ledger::kStateInlineTipRedditEnabled, false);
+  state.SetBoolKey(ledger::kStateInlineTipTwitterEnabled, false);
+  state.SetBoolKey(ledger::kStateInlineTipGithubEnabled, false);
+  state.SetDoubleKey(ledger::kStateParametersRate, 0.25);
+  state.SetDoubleKey(ledger::kStateParametersAutoContributeChoice, 20.0);
+  state.SetStringKey(ledger::kStateParametersAutoContributeChoices, "");
+  state.SetStringKey(ledger::kStateParametersTipChoices, "");
+  state.SetStringKey(ledger::kStateParametersMonthlyTipChoices, "");
+  state.SetBoolKey(ledger::kStateFetchOldBalance, false);
+  std::string json;
+  ASSERT_TRUE(base::JSONWriter::Write(state, &json));
+  proxy_->OnStateChanged(json);
+
+  bat_ledger::LedgerImpl ledger(proxy_.get());
+
+  // Visit 20 sites five times each, every visit long enough to be recorded
+  const uint32_t tab_id = 1;
+  uint64_t current_time = now;
+  for (int i = 0; i < 100; i++) {
+    const std::string domain =
+        base::StringPrintf("site%d.example.com", i % 20);
+    auto visit_data = ledger::VisitData::New();
+    visit_data->tld = domain;
+    visit_data->domain = domain;
+    visit_data->name = domain;
+    visit_data->path = "/";
+    visit_data->url = "https://" + domain + "/";
+    visit_data->tab_id = tab_id;
+
+    ledger.OnShow(tab_id, current_time);
+    ledger.OnLoad(std::move(visit_data), current_time);
+    current_time += 30;
+    ledger.OnUnload(tab_id, current_time);
+  }
+
+  base::RunLoop().RunUntilIdle();
+
+  // Every visit is written, so none of them was dropped before the save
+  EXPECT_GE(transaction_count, 100);
+}
+
+TEST_F(BatLedgerClientMojoProxyTest, StateIsReadOnce) {
+  EXPECT_CALL(mock_ledger_client_, GetDoubleState(ledger::kStateScoreA))
+      .Times(1)
+      .WillOnce(Return(14500.0));
+
+  EXPECT_EQ(proxy_->GetDoubleState(ledger::kStateScoreA), 14500.0);
+  EXPECT_EQ(proxy_->GetDoubleState(ledger::kStateScoreA), 14500.0);
+}
+
+TEST_F(BatLedgerClientMojoProxyTest, WritesUpdateMirror) {
+  EXPECT_CALL(mock_ledger_client_, GetInt64State(_)).Times(0);
+  EXPECT_CALL(mock_ledger_client_, GetStringState(_)).Times(0);
+  EXPECT_CALL(
+      mock_ledger_client_,
+      SetStringState(ledger::kStatePaymentId, "id"))
+      .Times(1);
+
+  proxy_->SetInt64State("test", -5);
+  proxy_->SetStringState(ledger::kStatePaymentId, "id");
+  EXPECT_EQ(proxy_->GetInt64State("test"), -5);
+  EXPECT_EQ(proxy_->GetStringState(ledger::kStatePaymentId), "id");
+
+  // Changes from the browser replace the mirrored value
+  proxy_->OnStateChanged("{\"wallet.payment_id\":\"other\"}");
+  EXPECT_EQ(proxy_->GetStringState(ledger::kStatePaymentId), "other");
+
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST_F(BatLedgerClientMojoProxyTest, ClearStateReadsDefault) {
+  EXPECT_CALL(mock_ledger_client_, GetIntegerState(ledger::kStateVersion))
+      .Times(1)
+      .WillOnce(Return(0));
+
+  proxy_->OnStateChanged("{\"version\":1}");
+  EXPECT_EQ(proxy_->GetIntegerState(ledger::kStateVersion), 1);
+
+  proxy_->ClearState(ledger::kStateVersion);
+  EXPECT_EQ(proxy_->GetIntegerState(ledger::kStateVersion), 0);
+  EXPECT_EQ(proxy_->GetIntegerState(ledger::kStateVersion), 0);
+}
+
+TEST_F(BatLedgerClientMojoProxyTest, OptionsAreReadOnce) {
+  EXPECT_CALL(
+      mock_ledger_client_,
+      GetUint64Option(ledger::kOptionPublisherListRefreshInterval))
+      .Times(1)
+      .WillOnce(Return(3600));
+
+  EXPECT_EQ(
+      proxy_->GetUint64Option(ledger::kOptionPublisherListRefreshInterval),
+      3600u);
+  EXPECT_EQ(
+      proxy_->GetUint64Option(ledger::kOptionPublisherListRefreshInterval),
+      3600u);
+}
+
+}  // namespace bat_ledger
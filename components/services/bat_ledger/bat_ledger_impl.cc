@@ -1076,4 +1076,8 @@ void BatLedgerImpl::GetAllPromotions(GetAllPromotionsCallback callback) {
           _1));
 }
 
+void BatLedgerImpl::OnStateChanged(const std::string& json) {
+  bat_ledger_client_mojo_proxy_->OnStateChanged(json);
+}
+
 }  // namespace bat_ledger
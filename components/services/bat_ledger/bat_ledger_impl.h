@@ -222,6 +222,8 @@ class BatLedgerImpl : public mojom::BatLedger,
 
   void GetAllPromotions(GetAllPromotionsCallback callback) override;
 
+  void OnStateChanged(const std::string& json) override;
+
  private:
   void SetCatalogIssuers(
       const std::string& info) override;
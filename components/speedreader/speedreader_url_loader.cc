@@ -12,6 +12,8 @@
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "brave/components/speedreader/speedreader_whitelist.h"
@@ -36,6 +38,44 @@ std::string GetDistilledPageResources() {
 
 }  // namespace
 
+class SpeedReaderURLLoader::Distiller {
+ public:
+  explicit Distiller(std::unique_ptr<Rewriter> rewriter)
+      : rewriter_(std::move(rewriter)) {}
+  ~Distiller() = default;
+
+  Distiller(const Distiller&) = delete;
+  Distiller& operator=(const Distiller&) = delete;
+
+  void Write(std::string chunk) {
+    if (failed_)
+      return;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    // Error occurred
+    if (rewriter_->Write(chunk.data(), chunk.length()) != 0)
+      failed_ = true;
+    elapsed_ += base::TimeTicks::Now() - start;
+  }
+
+  // Returns the distilled body, or nothing if the rewriter rejected the page
+  // in which case the original body should be used.
+  base::Optional<std::string> End() {
+    if (failed_)
+      return base::nullopt;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    rewriter_->End();
+    elapsed_ += base::TimeTicks::Now() - start;
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", elapsed_);
+    return rewriter_->GetOutput();
+  }
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+  bool failed_ = false;
+  // Time spent in the rewriter, which is spread over the whole download.
+  base::TimeDelta elapsed_;
+};
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -72,6 +112,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       destination_url_loader_client_(std::move(destination_url_loader_client)),
       response_url_(response_url),
       task_runner_(task_runner),
+      distill_task_runner_(base::CreateSequencedTaskRunner(
+          {base::ThreadPool(), base::TaskPriority::USER_BLOCKING})),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(distill_task_runner_)),
       body_consumer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              task_runner),
@@ -199,17 +242,15 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   DCHECK_EQ(State::kLoading, state_);
 
-  size_t start_size = buffered_body_.size();
+  std::string chunk(kReadBufferSize, '\0');
   uint32_t read_bytes = kReadBufferSize;
-  buffered_body_.resize(start_size + read_bytes);
   MojoResult result = body_consumer_handle_->ReadData(
-      &buffered_body_[0] + start_size, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
-      buffered_body_.resize(start_size);
       MaybeLaunchSpeedreader();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
@@ -221,11 +262,21 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   }
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
-  buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  chunk.resize(read_bytes);
+  buffered_body_.append(chunk);
+
+  // Distill the page while the rest of the body is still downloading. The
+  // rewriter is only used on |distill_task_runner_|, which owns the chunk.
+  if (read_bytes > 0 && whitelist_) {
+    if (!distiller_) {
+      distiller_.reset(
+          new Distiller(whitelist_->MakeRewriter(response_url_)));
+    }
+    distill_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Distiller::Write, base::Unretained(distiller_.get()),
+                       std::move(chunk)));
+  }
 
   body_consumer_watcher_.ArmOrNotify();
 }
@@ -249,32 +300,32 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
+  if (distiller_) {
+    // |distiller_| is deleted on |distill_task_runner_| after this task runs,
+    // so it is safe to use unretained.
     base::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              return GetDistilledPageResources() + transformed;
-            },
-            std::move(buffered_body_), whitelist_->MakeRewriter(response_url_)),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
+        distill_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&Distiller::End, base::Unretained(distiller_.get())),
+        base::BindOnce(&SpeedReaderURLLoader::OnDistillingFinished,
                        weak_factory_.GetWeakPtr()));
     return;
   }
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::OnDistillingFinished(
+    base::Optional<std::string> distilled_body) {
+  DCHECK_EQ(State::kLoading, state_);
+  distiller_.reset();
+
+  if (!distilled_body) {
+    CompleteLoading(std::move(buffered_body_));
+    return;
+  }
+
+  CompleteLoading(GetDistilledPageResources() + *distilled_body);
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
@@ -360,6 +411,7 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
+  distiller_.reset();
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
   source_url_loader_.reset();
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,8 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -39,10 +42,11 @@ class SpeedreaderWhitelist;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
-//            done, this loader will dispatch queued messages like
+// kLoading: Receives the body from the source loader and feeds each chunk to
+//            the distiller on a worker sequence as it arrives. The received
+//            body is also kept in this loader so it can be sent untouched if
+//            distilling fails. When all body has been received and distilling
+//            is done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
 // kSending: Receives the body and sends it to the destination loader client.
@@ -112,6 +116,7 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  void OnDistillingFinished(base::Optional<std::string> distilled_body);
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
@@ -120,6 +125,9 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   void Abort();
 
+  // Distills the body incrementally. Lives on |distill_task_runner_|.
+  class Distiller;
+
   base::WeakPtr<SpeedReaderThrottle> throttle_;
 
   mojo::Receiver<network::mojom::URLLoaderClient> source_url_client_receiver_{
@@ -141,6 +149,9 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   std::string buffered_body_;
   size_t bytes_remaining_in_buffer_;
 
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<Distiller, base::OnTaskRunnerDeleter> distiller_;
+
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
   mojo::SimpleWatcher body_consumer_watcher_;
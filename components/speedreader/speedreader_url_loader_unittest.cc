@@ -0,0 +1,205 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_url_loader.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "brave/components/speedreader/speedreader_switches.h"
+#include "brave/components/speedreader/speedreader_throttle.h"
+#include "brave/components/speedreader/speedreader_whitelist.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_utils.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "services/network/test/test_url_loader_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=SpeedReaderURLLoaderTest.*
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kTestUrl[] = "https://theguardian.com/guardian.html";
+
+// Intercepts the response like the navigation loader does, so that the test
+// can act as both the source and the destination of the SpeedReaderURLLoader.
+class TestDelegate : public blink::URLLoaderThrottle::Delegate {
+ public:
+  TestDelegate() = default;
+  ~TestDelegate() override = default;
+
+  TestDelegate(const TestDelegate&) = delete;
+  TestDelegate& operator=(const TestDelegate&) = delete;
+
+  // blink::URLLoaderThrottle::Delegate:
+  void CancelWithError(int error_code,
+                       base::StringPiece custom_reason) override {
+    NOTREACHED();
+  }
+
+  void Resume() override { is_resumed_ = true; }
+
+  void InterceptResponse(
+      mojo::PendingRemote<network::mojom::URLLoader> new_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>
+          new_client_receiver,
+      mojo::PendingRemote<network::mojom::URLLoader>* original_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>*
+          original_client_receiver) override {
+    destination_loader_remote_.Bind(std::move(new_loader));
+    ASSERT_TRUE(mojo::FusePipes(std::move(new_client_receiver),
+                                destination_loader_client_.CreateRemote()));
+    source_loader_receiver_ = original_loader->InitWithNewPipeAndPassReceiver();
+    *original_client_receiver =
+        source_loader_client_remote_.BindNewPipeAndPassReceiver();
+  }
+
+  // Sends |body| to the SpeedReaderURLLoader in chunks of |chunk_size| bytes.
+  void LoadResponseBody(const std::string& body, size_t chunk_size) {
+    MojoCreateDataPipeOptions options;
+    options.struct_size = sizeof(MojoCreateDataPipeOptions);
+    options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+    options.element_num_bytes = 1;
+    options.capacity_num_bytes = chunk_size;
+    mojo::ScopedDataPipeProducerHandle producer;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    ASSERT_EQ(MOJO_RESULT_OK,
+              mojo::CreateDataPipe(&options, &producer, &consumer));
+    source_loader_client_remote_->OnStartLoadingResponseBody(
+        std::move(consumer));
+
+    size_t offset = 0;
+    while (offset < body.size()) {
+      uint32_t bytes = std::min(chunk_size, body.size() - offset);
+      ASSERT_EQ(MOJO_RESULT_OK,
+                producer->WriteData(body.data() + offset, &bytes,
+                                    MOJO_WRITE_DATA_FLAG_ALL_OR_NONE));
+      offset += bytes;
+      // Let the loader drain the pipe before the next chunk.
+      base::RunLoop().RunUntilIdle();
+    }
+    producer.reset();
+    source_loader_client_remote_->OnComplete(
+        network::URLLoaderCompletionStatus(net::OK));
+  }
+
+  bool is_resumed() const { return is_resumed_; }
+
+  network::TestURLLoaderClient* destination_loader_client() {
+    return &destination_loader_client_;
+  }
+
+ private:
+  bool is_resumed_ = false;
+
+  mojo::Remote<network::mojom::URLLoader> destination_loader_remote_;
+  network::TestURLLoaderClient destination_loader_client_;
+
+  mojo::PendingReceiver<network::mojom::URLLoader> source_loader_receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> source_loader_client_remote_;
+};
+
+}  // namespace
+
+class SpeedReaderURLLoaderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir));
+    ASSERT_TRUE(base::ReadFileToString(
+        test_data_dir.AppendASCII("guardian.html"), &page_));
+
+    // Load the whitelist from the test data rather than the component.
+    base::CommandLine::ForCurrentProcess()->AppendSwitchPath(
+        kSpeedreaderWhitelistPath,
+        test_data_dir.AppendASCII("speedreader_whitelist.json"));
+    whitelist_ = std::make_unique<SpeedreaderWhitelist>(nullptr);
+    task_environment_.RunUntilIdle();
+    ASSERT_TRUE(whitelist_->IsWhitelisted(GURL(kTestUrl)));
+  }
+
+  void TearDown() override {
+    base::CommandLine::ForCurrentProcess()->RemoveSwitch(
+        kSpeedreaderWhitelistPath);
+  }
+
+  // Distills |page_| with a single Write() of the whole document.
+  std::string DistillAtOnce() {
+    std::unique_ptr<Rewriter> rewriter =
+        whitelist_->MakeRewriter(GURL(kTestUrl));
+    EXPECT_EQ(0, rewriter->Write(page_.data(), page_.length()));
+    rewriter->End();
+    return rewriter->GetOutput();
+  }
+
+  // Loads |page_| through a SpeedReaderThrottle in chunks of |chunk_size|
+  // bytes and returns the body received by the destination.
+  std::string Load(size_t chunk_size) {
+    SpeedReaderThrottle throttle(whitelist_.get(),
+                                 base::ThreadTaskRunnerHandle::Get());
+    TestDelegate delegate;
+    throttle.set_delegate(&delegate);
+
+    auto response_head = network::mojom::URLResponseHead::New();
+    bool defer = false;
+    throttle.WillProcessResponse(GURL(kTestUrl), response_head.get(), &defer);
+    EXPECT_TRUE(defer);
+    EXPECT_FALSE(delegate.is_resumed());
+
+    delegate.LoadResponseBody(page_, chunk_size);
+    delegate.destination_loader_client()->RunUntilComplete();
+    EXPECT_TRUE(delegate.is_resumed());
+    EXPECT_EQ(net::OK,
+              delegate.destination_loader_client()->completion_status()
+                  .error_code);
+
+    std::string body;
+    EXPECT_TRUE(mojo::BlockingCopyToString(
+        delegate.destination_loader_client()->response_body_release(), &body));
+    return body;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<SpeedreaderWhitelist> whitelist_;
+  std::string page_;
+};
+
+TEST_F(SpeedReaderURLLoaderTest, DistillsBodyReadInChunks) {
+  const std::string expected = DistillAtOnce();
+  ASSERT_FALSE(expected.empty());
+  ASSERT_LT(expected.size(), page_.size());
+
+  // Smaller than the loader's read buffer, so the rewriter is fed many times
+  // while the body is still arriving.
+  const std::string body = Load(4096);
+  EXPECT_TRUE(base::StartsWith(body, "<style id=\"brave_speedreader_style\">",
+                               base::CompareCase::SENSITIVE));
+  EXPECT_TRUE(base::EndsWith(body, expected, base::CompareCase::SENSITIVE));
+}
+
+TEST_F(SpeedReaderURLLoaderTest, ChunkSizeDoesNotChangeOutput) {
+  EXPECT_EQ(Load(page_.size()), Load(1000));
+}
+
+}  // namespace speedreader
@@ -47,44 +47,40 @@ GURL GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
+// Returns the rules whose primary pattern matches |primary_url|, keeping
+// their precedence order
+ContentSettingsForOneType GetRulesMatchingPrimaryURL(
+    const ContentSettingsForOneType& rules,
+    const GURL& primary_url) {
+  ContentSettingsForOneType matching_rules;
   for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
-    }
+    if (rule.primary_pattern.Matches(primary_url))
+      matching_rules.push_back(rule);
   }
-
-  return setting == CONTENT_SETTING_BLOCK;
+  return matching_rules;
 }
 
-template <typename URL>
-ContentSetting GetBraveContentSettingFromRules(
-    const ContentSettingsForOneType& shield_rules,
+// Returns the setting of the first rule whose secondary pattern matches
+// |secondary_url|, assuming the primary patterns were already matched
+ContentSetting GetContentSettingForSecondaryURL(
     const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
-    const URL& secondary_url) {
-  // if shields is down, allow everything
-  if (IsBraveShieldsDown(frame, secondary_url, shield_rules))
-    return CONTENT_SETTING_ALLOW;
-
-  const GURL& primary_url = GetOriginOrURL(frame);
-  const GURL& secondary_gurl = secondary_url;
+    const GURL& secondary_url) {
   for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_gurl)) {
+    if (rule.secondary_pattern.Matches(secondary_url))
       return rule.GetContentSetting();
-    }
   }
   return CONTENT_SETTING_DEFAULT;
 }
 
+// Content settings patterns only look at the scheme, host and port of http
+// and https URLs, so any URL with the same origin matches the same rules
+std::string GetSecondaryURLCacheKey(
+    const GURL& secondary_url) {
+  if (secondary_url.SchemeIsHTTPOrHTTPS())
+    return secondary_url.GetOrigin().spec();
+  return secondary_url.spec();
+}
+
 }  // namespace
 
 BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
@@ -119,6 +115,7 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    document_rules_.reset();
   }
 
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(
@@ -228,12 +225,60 @@ ContentSetting BraveContentSettingsAgentImpl::GetFPContentSettingFromRules(
   return CONTENT_SETTING_BLOCK;
 }
 
+BraveContentSettingsAgentImpl::DocumentRules::DocumentRules() = default;
+
+BraveContentSettingsAgentImpl::DocumentRules::~DocumentRules() = default;
+
+BraveContentSettingsAgentImpl::DocumentRules*
+BraveContentSettingsAgentImpl::GetDocumentRules(
+    const blink::WebFrame* frame) {
+  if (!content_setting_rules_)
+    return nullptr;
+
+  const GURL& primary_url = GetOriginOrURL(frame);
+  if (document_rules_ &&
+      document_rules_->rules_version ==
+          content_setting_rules_->brave_rules_version &&
+      document_rules_->primary_url == primary_url) {
+    return &document_rules_.value();
+  }
+
+  document_rules_.emplace();
+  document_rules_->rules_version = content_setting_rules_->brave_rules_version;
+  document_rules_->primary_url = primary_url;
+  document_rules_->brave_shields_rules = GetRulesMatchingPrimaryURL(
+      content_setting_rules_->brave_shields_rules, primary_url);
+  document_rules_->fingerprinting_rules = GetRulesMatchingPrimaryURL(
+      content_setting_rules_->fingerprinting_rules, primary_url);
+
+  // autoplay rules with a wildcard primary pattern are handled upstream
+  for (const auto& rule : GetRulesMatchingPrimaryURL(
+           content_setting_rules_->autoplay_rules, primary_url)) {
+    if (rule.primary_pattern == ContentSettingsPattern::Wildcard())
+      continue;
+    document_rules_->autoplay_rules.push_back(rule);
+  }
+
+  return &document_rules_.value();
+}
+
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::IsBraveShieldsDown(frame, secondary_url,
-                              content_setting_rules_->brave_shields_rules);
+  DocumentRules* document_rules = GetDocumentRules(frame);
+  if (!document_rules)
+    return true;
+
+  const std::string key = GetSecondaryURLCacheKey(secondary_url);
+  const auto iter = document_rules->brave_shields_down.find(key);
+  if (iter != document_rules->brave_shields_down.end())
+    return iter->second;
+
+  const bool is_brave_shields_down =
+      GetContentSettingForSecondaryURL(document_rules->brave_shields_rules,
+                                       secondary_url) == CONTENT_SETTING_BLOCK;
+  document_rules->brave_shields_down.emplace(key, is_brave_shields_down);
+  return is_brave_shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -258,11 +303,24 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
-    setting = GetBraveContentSettingFromRules(
-        content_setting_rules_->brave_shields_rules,
-        content_setting_rules_->fingerprinting_rules, frame,
+  DocumentRules* document_rules = GetDocumentRules(frame);
+  if (document_rules) {
+    const GURL secondary_url(
         url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
+    // if shields is down, allow everything
+    if (IsBraveShieldsDown(frame, secondary_url)) {
+      setting = CONTENT_SETTING_ALLOW;
+    } else {
+      const std::string key = GetSecondaryURLCacheKey(secondary_url);
+      const auto iter = document_rules->fingerprinting_settings.find(key);
+      if (iter != document_rules->fingerprinting_settings.end()) {
+        setting = iter->second;
+      } else {
+        setting = GetContentSettingForSecondaryURL(
+            document_rules->fingerprinting_rules, secondary_url);
+        document_rules->fingerprinting_settings.emplace(key, setting);
+      }
+    }
   }
 
   if (setting == CONTENT_SETTING_BLOCK) {
@@ -288,21 +346,20 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool default_value) {
 
   // respect user's site blocklist, if any
   bool ask = false;
-  const GURL& primary_url = GetOriginOrURL(frame);
   const GURL& secondary_url =
       url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL();
-  for (const auto& rule : content_setting_rules_->autoplay_rules) {
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard())
-        continue;
-    if (rule.primary_pattern.Matches(primary_url) &&
-        (rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         rule.secondary_pattern.Matches(secondary_url))) {
-      if (rule.GetContentSetting() == CONTENT_SETTING_BLOCK) {
-        VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
-        return false;
-      } else if (rule.GetContentSetting() == CONTENT_SETTING_ASK) {
-        VLOG(1) << "AllowAutoplay=ask because rule=CONTENT_SETTING_ASK";
-        ask = true;
+  DocumentRules* document_rules = GetDocumentRules(frame);
+  if (document_rules) {
+    for (const auto& rule : document_rules->autoplay_rules) {
+      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
+          rule.secondary_pattern.Matches(secondary_url)) {
+        if (rule.GetContentSetting() == CONTENT_SETTING_BLOCK) {
+          VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
+          return false;
+        } else if (rule.GetContentSetting() == CONTENT_SETTING_ASK) {
+          VLOG(1) << "AllowAutoplay=ask because rule=CONTENT_SETTING_ASK";
+          ask = true;
+        }
       }
     }
   }
@@ -6,9 +6,13 @@
 #ifndef BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 #define BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "chrome/renderer/content_settings_agent_impl.h"
@@ -47,6 +51,28 @@ class BraveContentSettingsAgentImpl
     const base::string16& details);
 
  private:
+  // Rules from |content_setting_rules_| whose primary pattern matches the top
+  // frame origin of the current document, in precedence order, together with
+  // the results of matching them against secondary URLs. Like upstream's
+  // |cached_script_permissions_| this is reset when a new document commits.
+  // The rules are updated in place by SetContentSettingRules, so an update is
+  // detected through their |brave_rules_version| rather than their address
+  struct DocumentRules {
+    DocumentRules();
+    ~DocumentRules();
+
+    uint64_t rules_version = 0;
+    GURL primary_url;
+    ContentSettingsForOneType brave_shields_rules;
+    ContentSettingsForOneType fingerprinting_rules;
+    ContentSettingsForOneType autoplay_rules;
+    base::flat_map<std::string, bool> brave_shields_down;
+    base::flat_map<std::string, ContentSetting> fingerprinting_settings;
+  };
+
+  DocumentRules* GetDocumentRules(
+      const blink::WebFrame* frame);
+
   ContentSetting GetFPContentSettingFromRules(
       const ContentSettingsForOneType& rules,
       const blink::WebFrame* frame,
@@ -74,6 +100,8 @@ class BraveContentSettingsAgentImpl
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  base::Optional<DocumentRules> document_rules_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -421,6 +421,34 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
   EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
 }
 
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
+                       FarbleGetImageDataAfterRulesUpdate) {
+  // Farbling should be balanced by default. This also caches the rules that
+  // match the top frame document.
+  NavigateToPageWithIframe();
+  int hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+
+  // Rules updated while the document stays loaded should replace the cached
+  // ones. Navigating the iframe creates a new frame, which pushes the updated
+  // rules to the renderer without committing a new top frame document.
+  AllowFingerprinting();
+  NavigateIframe(cross_site_url());
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
+
+  BlockFingerprinting();
+  NavigateIframe(same_site_url());
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingMaximum, hash);
+}
+
 class BraveContentSettingsAgentImplV2BrowserTest
     : public BraveContentSettingsAgentImplBrowserTest {
  public:
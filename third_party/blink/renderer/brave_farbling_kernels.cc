@@ -0,0 +1,72 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_kernels.h"
+
+#include "base/logging.h"
+
+namespace brave {
+
+uint64_t lfsr_jump(uint64_t v, size_t n) {
+  DCHECK_GE(n, 1u);
+  DCHECK_LE(n, kMaximumLfsrJump);
+
+  // |lfsr_next| shifts right by one and only writes the top two bits, so
+  // after |n| steps bits 0 to 62 - n are the original bits n to 62. Bits
+  // shifted in at the top are XORs of adjacent original low bits, except the
+  // first which also absorbs the original top bit
+  const uint64_t d = v ^ (v >> 1);
+  const uint64_t one = 1;
+  return ((v >> n) & ((one << (63 - n)) - 1)) |
+         (((v >> 63) | (d & 1)) << (63 - n)) |
+         (((d >> 1) & ((one << (n - 1)) - 1)) << (64 - n)) |
+         (((d >> n) & 1) << 63);
+}
+
+void FillWithPseudoRandomBytes(
+    uint64_t seed,
+    uint8_t* data,
+    size_t size) {
+  uint64_t v = seed;
+  size_t i = 0;
+
+  // The low byte of each of the next |kMaximumLfsrJump| values is made of
+  // bits of the current value, so fill whole blocks without stepping the
+  // sequence one value at a time
+  for (; i + kMaximumLfsrJump <= size; i += kMaximumLfsrJump) {
+    for (size_t j = 0; j < kMaximumLfsrJump; j++) {
+      data[i + j] = static_cast<uint8_t>(v >> j);
+    }
+    v = lfsr_jump(v, kMaximumLfsrJump);
+  }
+
+  for (; i < size; i++) {
+    data[i] = v % 256;
+    v = lfsr_next(v);
+  }
+}
+
+void ScaleAudioSamples(
+    double fudge_factor,
+    float* data,
+    size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    data[i] = data[i] * fudge_factor;
+  }
+}
+
+void FillWithPseudoRandomAudioSamples(
+    uint64_t seed,
+    float* data,
+    size_t count) {
+  const double maxUInt64AsDouble = UINT64_MAX;
+  uint64_t v = seed;
+  for (size_t i = 0; i < count; i++) {
+    v = lfsr_next(v);
+    data[i] = (v / maxUInt64AsDouble) / 10;
+  }
+}
+
+}  // namespace brave
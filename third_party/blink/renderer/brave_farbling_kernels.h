@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_KERNELS_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Returns the next value in the farbling PRNG sequence
+inline uint64_t lfsr_next(uint64_t v) {
+  const uint64_t zero = 0;
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+// Maximum number of steps |lfsr_jump| can advance the sequence by at once
+constexpr size_t kMaximumLfsrJump = 56;
+
+// Returns the value after |n| steps of |lfsr_next|, where 1 <= n <= 56
+uint64_t lfsr_jump(uint64_t v, size_t n);
+
+// Overwrites |data| with the low byte of each value in the PRNG sequence
+// starting at |seed|, i.e. data[i] = v % 256 followed by v = lfsr_next(v)
+void FillWithPseudoRandomBytes(
+    uint64_t seed,
+    uint8_t* data,
+    size_t size);
+
+// Multiplies each audio sample in |data| by |fudge_factor|
+void ScaleAudioSamples(
+    double fudge_factor,
+    float* data,
+    size_t count);
+
+// Overwrites |data| with pseudo-random audio samples between 0 and 0.1 from
+// the PRNG sequence starting after |seed|
+void FillWithPseudoRandomAudioSamples(
+    uint64_t seed,
+    float* data,
+    size_t count);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_KERNELS_H_
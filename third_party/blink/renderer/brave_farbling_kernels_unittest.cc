@@ -0,0 +1,102 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_kernels.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveFarblingKernelsTest.*
+
+namespace {
+
+// Seeds are chosen to cover all bits clear, all bits set, only the top bit
+// set and a typical domain key
+const uint64_t kSeeds[] = {
+  0x0000000000000000ULL,
+  0xffffffffffffffffULL,
+  0x8000000000000000ULL,
+  0x7b35e177a2288418ULL,
+};
+
+// Buffer sizes shorter than, equal to and not a multiple of the block size
+const size_t kSizes[] = {0, 1, 7, 55, 56, 57, 112, 1000, 4 * 33 * 17};
+
+// Scalar reference implementations which the kernels must match exactly
+
+std::vector<uint8_t> ScalarPseudoRandomBytes(uint64_t v, size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = v % 256;
+    v = brave::lfsr_next(v);
+  }
+  return data;
+}
+
+std::vector<float> ScalarPseudoRandomAudioSamples(uint64_t v, size_t count) {
+  const double maxUInt64AsDouble = UINT64_MAX;
+  std::vector<float> data(count);
+  for (size_t i = 0; i < count; i++) {
+    v = brave::lfsr_next(v);
+    data[i] = (v / maxUInt64AsDouble) / 10;
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(BraveFarblingKernelsTest, LfsrNext) {
+  EXPECT_EQ(0ULL, brave::lfsr_next(0ULL));
+  EXPECT_EQ(0x7fffffffffffffffULL, brave::lfsr_next(0xffffffffffffffffULL));
+  EXPECT_EQ(0x4000000000000000ULL, brave::lfsr_next(0x0000000000000001ULL));
+  EXPECT_EQ(0xc000000000000001ULL, brave::lfsr_next(0x0000000000000002ULL));
+}
+
+TEST(BraveFarblingKernelsTest, LfsrJumpMatchesRepeatedSteps) {
+  for (const uint64_t seed : kSeeds) {
+    uint64_t v = seed;
+    for (size_t n = 1; n <= brave::kMaximumLfsrJump; n++) {
+      v = brave::lfsr_next(v);
+      EXPECT_EQ(v, brave::lfsr_jump(seed, n)) << seed << " " << n;
+    }
+  }
+}
+
+TEST(BraveFarblingKernelsTest, FillWithPseudoRandomBytes) {
+  for (const uint64_t seed : kSeeds) {
+    for (const size_t size : kSizes) {
+      std::vector<uint8_t> data(size, 0x55);
+      brave::FillWithPseudoRandomBytes(seed, data.data(), data.size());
+      EXPECT_EQ(ScalarPseudoRandomBytes(seed, size), data)
+          << seed << " " << size;
+    }
+  }
+}
+
+TEST(BraveFarblingKernelsTest, ScaleAudioSamples) {
+  const double fudge_factor = 0.99 + (0x7b35e177a2288418ULL / 1.8e21);
+  std::vector<float> data = {0.0f, 1.0f, -1.0f, 0.5f, 0.12345f, -0.75f};
+
+  std::vector<float> expected_data;
+  for (const float value : data) {
+    expected_data.push_back(value * fudge_factor);
+  }
+
+  brave::ScaleAudioSamples(fudge_factor, data.data(), data.size());
+
+  EXPECT_EQ(expected_data, data);
+}
+
+TEST(BraveFarblingKernelsTest, FillWithPseudoRandomAudioSamples) {
+  for (const uint64_t seed : kSeeds) {
+    for (const size_t count : kSizes) {
+      std::vector<float> data(count, 1.0f);
+      brave::FillWithPseudoRandomAudioSamples(seed, data.data(), data.size());
+      EXPECT_EQ(ScalarPseudoRandomAudioSamples(seed, count), data)
+          << seed << " " << count;
+    }
+  }
+}